@@ -0,0 +1,269 @@
+#pragma once
+
+#ifndef GUAP_ALGO_CONSOLE_H
+#define GUAP_ALGO_CONSOLE_H
+
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+struct end_of_input final : std::runtime_error {
+    end_of_input()
+        : std::runtime_error("end of input") {}
+};
+
+struct console_writer final {
+private:
+    std::FILE* file_;
+    std::string buffer_;
+    size_t limit_;
+
+public:
+    explicit console_writer(std::FILE* file = stdout, size_t limit = 1 << 16)
+        : file_(file)
+        , limit_(limit) {
+        buffer_.reserve(limit_);
+    }
+
+    console_writer(const console_writer&)            = delete;
+    console_writer& operator=(const console_writer&) = delete;
+
+    ~console_writer() {
+        flush();
+    }
+
+    template <typename... Args>
+    void print(std::format_string<Args...> format, Args&&... args) {
+        std::format_to(std::back_inserter(buffer_), format, std::forward<Args>(args)...);
+        if (buffer_.size() >= limit_) {
+            flush();
+        }
+    }
+
+    template <typename... Args>
+    void println(std::format_string<Args...> format, Args&&... args) {
+        std::format_to(std::back_inserter(buffer_), format, std::forward<Args>(args)...);
+        println();
+    }
+
+    void println() {
+        buffer_ += '\n';
+        if (buffer_.size() >= limit_) {
+            flush();
+        }
+    }
+
+    void write(std::string_view text) {
+        buffer_ += text;
+        if (buffer_.size() >= limit_) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (buffer_.empty()) {
+            return;
+        }
+        std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        std::fflush(file_);
+        buffer_.clear();
+    }
+};
+
+struct console_reader final {
+private:
+    std::FILE* file_;
+    std::vector<char> buffer_;
+    size_t begin_ = 0;
+    size_t end_   = 0;
+    bool eof_     = false;
+
+    console_writer* tie_ = nullptr;
+
+    bool fill_() {
+        if (eof_) {
+            return false;
+        }
+        if (tie_) {
+            tie_->flush();
+        }
+
+        if (begin_ > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+            end_   -= begin_;
+            begin_  = 0;
+        }
+        if (end_ == buffer_.size()) {
+            buffer_.resize(buffer_.size() * 2);
+        }
+
+#if defined(_WIN32)
+        auto count = ::_read(
+            ::_fileno(file_),
+            buffer_.data() + end_,
+            static_cast<unsigned>(buffer_.size() - end_)
+        );
+#else
+        auto count = ::read(::fileno(file_), buffer_.data() + end_, buffer_.size() - end_);
+#endif
+        if (count <= 0) {
+            eof_ = true;
+            return false;
+        }
+        end_ += static_cast<size_t>(count);
+        return true;
+    }
+
+    bool skip_spaces_() {
+        while (true) {
+            while (begin_ < end_ && std::isspace(static_cast<unsigned char>(buffer_[begin_]))) {
+                begin_++;
+            }
+            if (begin_ < end_) {
+                return true;
+            }
+            if (!fill_()) {
+                return false;
+            }
+        }
+    }
+
+public:
+    explicit console_reader(std::FILE* file = stdin, size_t block = 1 << 16)
+        : file_(file)
+        , buffer_(block) {}
+
+    console_reader(const console_reader&)            = delete;
+    console_reader& operator=(const console_reader&) = delete;
+
+    void tie(console_writer* writer) {
+        tie_ = writer;
+    }
+
+    std::string_view token() {
+        if (!skip_spaces_()) {
+            throw end_of_input();
+        }
+
+        size_t length = 0;
+        while (true) {
+            while (begin_ + length < end_ &&
+                   !std::isspace(static_cast<unsigned char>(buffer_[begin_ + length]))) {
+                length++;
+            }
+            if (begin_ + length < end_ || !fill_()) {
+                break;
+            }
+        }
+
+        std::string_view result(buffer_.data() + begin_, length);
+        begin_ += length;
+        return result;
+    }
+
+    template <typename T>
+    std::optional<T> read() {
+        if constexpr (std::is_same_v<T, char>) {
+            if (!skip_spaces_()) {
+                throw end_of_input();
+            }
+            return buffer_[begin_++];
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return std::string(token());
+        } else {
+            auto text         = token();
+            auto last         = text.data() + text.size();
+            T value           = {};
+            auto [end, error] = std::from_chars(text.data(), last, value);
+            if (error != std::errc{} || end != last) {
+                return {};
+            }
+            return value;
+        }
+    }
+
+    void skip_line() {
+        while (true) {
+            while (begin_ < end_) {
+                if (buffer_[begin_++] == '\n') {
+                    return;
+                }
+            }
+            if (!fill_()) {
+                return;
+            }
+        }
+    }
+};
+
+struct console final {
+    console_writer out;
+    console_reader in;
+
+private:
+    std::FILE* input_;
+    bool interactive_;
+
+public:
+    explicit console(std::FILE* input = stdin, bool interactive = true)
+        : in(input)
+        , input_(input)
+        , interactive_(interactive) {
+        in.tie(&out);
+    }
+
+    console(const console&)            = delete;
+    console& operator=(const console&) = delete;
+
+    ~console() {
+        out.flush();
+        if (input_ != stdin) {
+            std::fclose(input_);
+        }
+    }
+
+    bool is_interactive() const {
+        return interactive_;
+    }
+
+    void prompt(std::string_view text) {
+        if (interactive_) {
+            out.write(text);
+        }
+    }
+
+    template <typename T>
+    std::optional<T> scan() {
+        auto value = in.read<T>();
+        if (!value.has_value()) {
+            in.skip_line();
+            out.println("Ошибка ввода. Попробуйте снова.");
+        }
+        return value;
+    }
+};
+
+inline std::FILE* open_script(std::string_view path) {
+    if (path == "-") {
+        return stdin;
+    }
+    return std::fopen(std::string(path).c_str(), "rb");
+}
+
+#endif  // GUAP_ALGO_CONSOLE_H
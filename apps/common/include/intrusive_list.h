@@ -0,0 +1,442 @@
+#pragma once
+
+#ifndef GUAP_ALGO_INTRUSIVE_LIST_H
+#define GUAP_ALGO_INTRUSIVE_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+template <typename T>
+struct list_hook final {
+    T* next = nullptr;
+    T* prev = nullptr;
+};
+
+template <typename T, list_hook<T> T::*Hook, typename Allocator = std::allocator<T>>
+struct intrusive_list final {
+private:
+    using alloc_traits   = std::allocator_traits<Allocator>;
+    using allocator_type = typename alloc_traits::template rebind_alloc<T>;
+    using node_traits    = std::allocator_traits<allocator_type>;
+
+    [[no_unique_address]] allocator_type alloc_ = {};
+
+    T* head_     = nullptr;
+    T* tail_     = nullptr;
+    size_t size_ = 0;
+
+    static constexpr list_hook<T>& hook_(T* node) {
+        return node->*Hook;
+    }
+
+    constexpr void link_before_(T* pos, T* node) {
+        auto& hook = hook_(node);
+        hook.next  = pos;
+        hook.prev  = pos ? hook_(pos).prev : tail_;
+
+        if (hook.prev) {
+            hook_(hook.prev).next = node;
+        } else {
+            head_ = node;
+        }
+        if (pos) {
+            hook_(pos).prev = node;
+        } else {
+            tail_ = node;
+        }
+        size_++;
+    }
+
+    constexpr void unlink_(T* node) {
+        auto& hook = hook_(node);
+        if (hook.prev) {
+            hook_(hook.prev).next = hook.next;
+        } else {
+            head_ = hook.next;
+        }
+        if (hook.next) {
+            hook_(hook.next).prev = hook.prev;
+        } else {
+            tail_ = hook.prev;
+        }
+        hook = {};
+        size_--;
+    }
+
+    template <typename Less>
+    static constexpr T* merge_(T* lhs, T* rhs, Less& less) {
+        T* head  = nullptr;
+        T** tail = &head;
+        while (lhs && rhs) {
+            if (less(*rhs, *lhs)) {
+                *tail = rhs;
+                rhs   = hook_(rhs).next;
+            } else {
+                *tail = lhs;
+                lhs   = hook_(lhs).next;
+            }
+            tail = &hook_(*tail).next;
+        }
+        *tail = lhs ? lhs : rhs;
+        return head;
+    }
+
+    template <typename... Args>
+    constexpr T* create_(Args&&... args) {
+        auto* node = node_traits::allocate(alloc_, 1);
+        node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+        return node;
+    }
+
+    constexpr void destroy_(T* node) {
+        node_traits::destroy(alloc_, node);
+        node_traits::deallocate(alloc_, node, 1);
+    }
+
+    constexpr T* node_at_(size_t index) const {
+        if (index < size_ / 2) {
+            auto* current = head_;
+            while (index--) {
+                current = hook_(current).next;
+            }
+            return current;
+        }
+
+        auto* current = tail_;
+        for (auto i = size_ - 1; i != index; i--) {
+            current = hook_(current).prev;
+        }
+        return current;
+    }
+
+    template <bool Const>
+    struct basic_iterator final {
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using iterator_category = std::forward_iterator_tag;
+
+        T* current = nullptr;
+
+        constexpr basic_iterator() = default;
+        constexpr basic_iterator(T* node)
+            : current(node) {}
+
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        constexpr basic_iterator(basic_iterator<OtherConst> rhs)
+            : current(rhs.current) {}
+
+        constexpr basic_iterator& operator++() {
+            if (current) {
+                current = hook_(current).next;
+            }
+            return *this;
+        }
+
+        constexpr basic_iterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr reference operator*() const {
+            return *current;
+        }
+
+        constexpr pointer operator->() const {
+            return current;
+        }
+
+        constexpr bool operator==(const basic_iterator& rhs) const {
+            return current == rhs.current;
+        }
+    };
+
+public:
+    using value_type     = T;
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    struct node_handle final {
+    private:
+        friend intrusive_list;
+
+        T* node_ = nullptr;
+        [[no_unique_address]] allocator_type alloc_ = {};
+
+        constexpr node_handle(T* node, const allocator_type& alloc)
+            : node_(node)
+            , alloc_(alloc) {}
+
+        constexpr T* release_() {
+            return std::exchange(node_, nullptr);
+        }
+
+    public:
+        constexpr node_handle() = default;
+        constexpr ~node_handle() {
+            if (node_) {
+                node_traits::destroy(alloc_, node_);
+                node_traits::deallocate(alloc_, node_, 1);
+            }
+        }
+
+        node_handle(const node_handle&)            = delete;
+        node_handle& operator=(const node_handle&) = delete;
+
+        constexpr node_handle(node_handle&& rhs) noexcept
+            : node_(rhs.release_())
+            , alloc_(rhs.alloc_) {}
+
+        constexpr node_handle& operator=(node_handle&& rhs) noexcept {
+            std::swap(node_, rhs.node_);
+            std::swap(alloc_, rhs.alloc_);
+            return *this;
+        }
+
+        constexpr bool is_empty() const {
+            return node_ == nullptr;
+        }
+
+        explicit constexpr operator bool() const {
+            return node_ != nullptr;
+        }
+
+        constexpr T& value() const {
+            return *node_;
+        }
+    };
+
+    constexpr intrusive_list() = default;
+    explicit constexpr intrusive_list(const Allocator& alloc)
+        : alloc_(alloc) {}
+
+    constexpr ~intrusive_list() {
+        clear();
+    }
+
+    constexpr intrusive_list& operator=(const intrusive_list& rhs) {
+        if (this == &rhs) {
+            return *this;
+        }
+
+        clear();
+        for (const auto& value : rhs) {
+            push_back(value);
+        }
+
+        return *this;
+    }
+    constexpr intrusive_list(const intrusive_list& rhs)
+        : alloc_(node_traits::select_on_container_copy_construction(rhs.alloc_)) {
+        *this = rhs;
+    }
+
+    constexpr intrusive_list& operator=(intrusive_list&& rhs) noexcept {
+        if (this == &rhs) {
+            return *this;
+        }
+
+        std::swap(alloc_, rhs.alloc_);
+        std::swap(head_, rhs.head_);
+        std::swap(tail_, rhs.tail_);
+        std::swap(size_, rhs.size_);
+
+        return *this;
+    }
+    constexpr intrusive_list(intrusive_list&& rhs) noexcept {
+        *this = std::move(rhs);
+    }
+
+    constexpr size_t size() const {
+        return size_;
+    }
+
+    constexpr bool is_empty() const {
+        return size_ == 0;
+    }
+
+    constexpr T& front() {
+        return *head_;
+    }
+
+    constexpr const T& front() const {
+        return *head_;
+    }
+
+    constexpr T& back() {
+        return *tail_;
+    }
+
+    constexpr const T& back() const {
+        return *tail_;
+    }
+
+    template <typename... Args>
+    constexpr iterator emplace(const_iterator pos, Args&&... args) {
+        auto* node = create_(std::forward<Args>(args)...);
+        link_before_(pos.current, node);
+        return {node};
+    }
+
+    template <typename... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        auto* node = create_(std::forward<Args>(args)...);
+        link_before_(nullptr, node);
+        return *node;
+    }
+
+    constexpr void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    constexpr void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    constexpr void pop_back() {
+        if (!tail_) {
+            return;
+        }
+
+        auto* to_delete = tail_;
+        unlink_(to_delete);
+        destroy_(to_delete);
+    }
+
+    constexpr void pop_at(int index) {
+        if (index < 0 || static_cast<size_t>(index) >= size_) {
+            return;
+        }
+
+        auto* target = node_at_(index);
+        unlink_(target);
+        destroy_(target);
+    }
+
+    constexpr iterator erase(const_iterator it) {
+        if (it.current == nullptr) {
+            return end();
+        }
+
+        auto* next_node = hook_(it.current).next;
+        unlink_(it.current);
+        destroy_(it.current);
+
+        return {next_node};
+    }
+
+    constexpr node_handle extract(const_iterator it) {
+        if (it.current == nullptr) {
+            return {};
+        }
+
+        unlink_(it.current);
+        return {it.current, alloc_};
+    }
+
+    constexpr iterator insert(const_iterator pos, node_handle&& handle) {
+        if (handle.is_empty()) {
+            return {pos.current};
+        }
+
+        auto* node = handle.release_();
+        link_before_(pos.current, node);
+        return {node};
+    }
+
+    constexpr iterator push_back(node_handle&& handle) {
+        return insert(end(), std::move(handle));
+    }
+
+    constexpr iterator link_back(T& node) {
+        link_before_(nullptr, &node);
+        return {&node};
+    }
+
+    constexpr T* unlink(const_iterator it) {
+        if (it.current == nullptr) {
+            return nullptr;
+        }
+
+        unlink_(it.current);
+        return it.current;
+    }
+
+    template <class Comp = std::ranges::less, class Proj = std::identity>
+    constexpr void sort(Comp comp = {}, Proj proj = {}) {
+        if (size_ < 2) {
+            return;
+        }
+
+        auto less = [&comp, &proj](const T& lhs, const T& rhs) {
+            return std::invoke(comp, std::invoke(proj, lhs), std::invoke(proj, rhs));
+        };
+
+        T* bins[64] = {};
+        size_t used = 0;
+        for (auto* node = head_; node;) {
+            auto* next       = hook_(node).next;
+            hook_(node).next = nullptr;
+
+            size_t i = 0;
+            for (; i < used && bins[i]; i++) {
+                node    = merge_(bins[i], node, less);
+                bins[i] = nullptr;
+            }
+            bins[i] = node;
+            used    = std::max(used, i + 1);
+            node    = next;
+        }
+
+        T* result = nullptr;
+        for (size_t i = 0; i < used; i++) {
+            if (bins[i]) {
+                result = merge_(bins[i], result, less);
+            }
+        }
+
+        T* prev = nullptr;
+        for (auto* node = result; node; node = hook_(node).next) {
+            hook_(node).prev = prev;
+            prev             = node;
+        }
+        head_ = result;
+        tail_ = prev;
+    }
+
+    constexpr void splice(const_iterator pos, intrusive_list& other, const_iterator it) {
+        other.unlink_(it.current);
+        link_before_(pos.current, it.current);
+    }
+
+    constexpr void clear() {
+        while (tail_) {
+            pop_back();
+        }
+    }
+
+    constexpr iterator begin() {
+        return {head_};
+    }
+
+    constexpr iterator end() {
+        return {nullptr};
+    }
+
+    constexpr const_iterator begin() const {
+        return {head_};
+    }
+
+    constexpr const_iterator end() const {
+        return {nullptr};
+    }
+};
+
+#endif  // GUAP_ALGO_INTRUSIVE_LIST_H
@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef GUAP_ALGO_SORTING_NETWORK_H
+#define GUAP_ALGO_SORTING_NETWORK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+inline constexpr size_t sorting_network_max = 32;
+
+struct network_step final {
+    std::uint8_t lhs = 0;
+    std::uint8_t rhs = 0;
+};
+
+template <typename I>
+concept network_sortable = std::random_access_iterator<I> &&
+                           std::is_arithmetic_v<std::iter_value_t<I>> &&
+                           std::is_lvalue_reference_v<std::iter_reference_t<I>>;
+
+namespace detail {
+template <typename Emit>
+constexpr void bose_nelson_merge_(size_t i, size_t x, size_t j, size_t y, Emit& emit) {
+    if (x == 1 && y == 1) {
+        emit(i, j);
+    } else if (x == 1 && y == 2) {
+        emit(i, j + 1);
+        emit(i, j);
+    } else if (x == 2 && y == 1) {
+        emit(i, j);
+        emit(i + 1, j);
+    } else {
+        auto a = x / 2;
+        auto b = x % 2 ? y / 2 : (y + 1) / 2;
+        bose_nelson_merge_(i, a, j, b, emit);
+        bose_nelson_merge_(i + a, x - a, j + b, y - b, emit);
+        bose_nelson_merge_(i + a, x - a, j, b, emit);
+    }
+}
+
+template <typename Emit>
+constexpr void bose_nelson_(size_t i, size_t n, Emit& emit) {
+    if (n < 2) {
+        return;
+    }
+    auto a = n / 2;
+    bose_nelson_(i, a, emit);
+    bose_nelson_(i + a, n - a, emit);
+    bose_nelson_merge_(i, a, i + a, n - a, emit);
+}
+
+consteval size_t network_size_(size_t n) {
+    size_t count = 0;
+    auto emit    = [&count](size_t, size_t) { count++; };
+    bose_nelson_(0, n, emit);
+    return count;
+}
+
+template <size_t N>
+consteval auto make_network_() {
+    std::array<network_step, network_size_(N)> steps;
+    size_t count = 0;
+    auto emit    = [&steps, &count](size_t lhs, size_t rhs) {
+        steps[count++] = {static_cast<std::uint8_t>(lhs), static_cast<std::uint8_t>(rhs)};
+    };
+    bose_nelson_(0, N, emit);
+    return steps;
+}
+
+template <size_t... N>
+consteval auto make_network_sizes_(std::index_sequence<N...>) {
+    return std::array<size_t, sizeof...(N)>{network_size_(N)...};
+}
+}  // namespace detail
+
+template <size_t N>
+inline constexpr auto sorting_network = detail::make_network_<N>();
+
+inline constexpr auto sorting_network_sizes =
+    detail::make_network_sizes_(std::make_index_sequence<sorting_network_max + 1>{});
+
+template <size_t N, network_sortable I, typename Less>
+constexpr size_t sort_network(I first, Less&& less) {
+    constexpr auto& network = sorting_network<N>;
+
+    size_t swaps  = 0;
+    auto exchange = [&first, &less, &swaps](network_step step) {
+        auto& x = first[step.lhs];
+        auto& y = first[step.rhs];
+        auto a  = x;
+        auto b  = y;
+        bool s  = less(b, a);
+        x       = s ? b : a;
+        y       = s ? a : b;
+        swaps  += s;
+    };
+    [&exchange]<size_t... K>(std::index_sequence<K...>) {
+        (exchange(network[K]), ...);
+    }(std::make_index_sequence<network.size()>{});
+
+    return swaps;
+}
+
+template <network_sortable I, typename Less>
+constexpr size_t sort_network(I first, size_t n, Less&& less) {
+    size_t swaps = 0;
+    [&]<size_t... N>(std::index_sequence<N...>) {
+        ((n == N && (swaps = sort_network<N>(first, less), true)) || ...);
+    }(std::make_index_sequence<sorting_network_max + 1>{});
+    return swaps;
+}
+
+#endif  // GUAP_ALGO_SORTING_NETWORK_H
@@ -0,0 +1,173 @@
+#pragma once
+
+#ifndef GUAP_ALGO_WORK_STEALING_POOL_H
+#define GUAP_ALGO_WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct task_group final {
+    std::atomic<size_t> pending = 0;
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+};
+
+struct work_stealing_pool final {
+private:
+    struct queue final {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<queue>> queues_;
+    std::vector<std::jthread> workers_;
+
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+    std::atomic<size_t> queued_     = 0;
+    std::atomic<size_t> next_queue_ = 0;
+    bool stopping_                  = false;
+
+    static inline thread_local const work_stealing_pool* owner_ = nullptr;
+    static inline thread_local size_t owner_index_              = 0;
+
+    size_t current_index_() {
+        if (owner_ == this) {
+            return owner_index_;
+        }
+        return next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    bool take_(size_t index, std::function<void()>& task) {
+        for (size_t i = 0; i < queues_.size(); i++) {
+            auto& q = *queues_[(index + i) % queues_.size()];
+            std::lock_guard lock(q.mutex);
+            if (q.tasks.empty()) {
+                continue;
+            }
+            if (i == 0) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool run_one_(size_t index) {
+        std::function<void()> task;
+        if (!take_(index, task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    void worker_loop_(size_t index) {
+        owner_       = this;
+        owner_index_ = index;
+
+        while (true) {
+            if (run_one_(index)) {
+                continue;
+            }
+
+            std::unique_lock lock(idle_mutex_);
+            idle_cv_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+            if (stopping_ && queued_.load() == 0) {
+                return;
+            }
+        }
+    }
+
+public:
+    work_stealing_pool()
+        : work_stealing_pool(std::thread::hardware_concurrency()) {}
+
+    explicit work_stealing_pool(size_t thread_count) {
+        thread_count = std::max<size_t>(thread_count, 1);
+
+        queues_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++) {
+            queues_.push_back(std::make_unique<queue>());
+        }
+
+        workers_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++) {
+            workers_.emplace_back([this, i] { worker_loop_(i); });
+        }
+    }
+
+    work_stealing_pool(const work_stealing_pool&)            = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    ~work_stealing_pool() {
+        {
+            std::lock_guard lock(idle_mutex_);
+            stopping_ = true;
+        }
+        idle_cv_.notify_all();
+        workers_.clear();
+    }
+
+    size_t thread_count() const {
+        return workers_.size();
+    }
+
+    template <typename F>
+    void submit(task_group& group, F&& func) {
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+
+        auto& q = *queues_[current_index_()];
+        {
+            std::lock_guard lock(q.mutex);
+            q.tasks.emplace_back([&group, func = std::forward<F>(func)]() mutable {
+                try {
+                    func();
+                } catch (...) {
+                    std::lock_guard lock(group.error_mutex);
+                    if (!group.error) {
+                        group.error = std::current_exception();
+                    }
+                }
+                group.pending.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        {
+            std::lock_guard lock(idle_mutex_);
+            queued_.fetch_add(1, std::memory_order_relaxed);
+        }
+        idle_cv_.notify_one();
+    }
+
+    void wait(task_group& group) {
+        auto index = owner_ == this ? owner_index_ : 0;
+        while (group.pending.load(std::memory_order_acquire) > 0) {
+            if (!run_one_(index)) {
+                std::this_thread::yield();
+            }
+        }
+
+        std::lock_guard lock(group.error_mutex);
+        if (group.error) {
+            std::rethrow_exception(std::exchange(group.error, nullptr));
+        }
+    }
+};
+
+#endif  // GUAP_ALGO_WORK_STEALING_POOL_H
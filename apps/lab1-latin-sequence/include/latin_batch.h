@@ -0,0 +1,196 @@
+#pragma once
+
+#ifndef GUAP_ALGO_LATIN_BATCH_H
+#define GUAP_ALGO_LATIN_BATCH_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "latin_sequence.h"
+#include "work_stealing_pool.h"
+
+struct latin_rejected final {
+    size_t offset = 0;
+    char letter   = 0;
+};
+
+struct latin_result final {
+    std::string output;
+    std::vector<latin_rejected> rejected;
+};
+
+struct latin_file_result final {
+    bool done = false;
+    std::vector<latin_rejected> rejected;
+};
+
+struct latin_chunk final {
+    size_t unmatched = 0;
+    std::string output;
+    std::vector<latin_rejected> rejected;
+};
+
+struct latin_batch_engine final {
+private:
+    work_stealing_pool pool_;
+    char remover_ = '@';
+    char ender_   = '.';
+
+    std::string_view trim_to_ender_(std::string_view input) const {
+        if (auto pos = input.find(ender_); pos != std::string_view::npos) {
+            return input.substr(0, pos + 1);
+        }
+        return input;
+    }
+
+    latin_chunk compile_chunk_(std::string_view input, size_t offset = 0) const {
+        latin_chunk result;
+        result.output.reserve(input.size());
+
+        for (size_t i = 0; i < input.size(); i++) {
+            auto c = input[i];
+            if (c == remover_) {
+                if (result.output.empty()) {
+                    result.unmatched++;
+                } else {
+                    result.output.pop_back();
+                }
+            } else if (is_latin_letter(c) || c == ender_) {
+                result.output.push_back(c);
+            } else if (!std::isspace(static_cast<unsigned char>(c))) {
+                result.rejected.push_back({offset + i, c});
+            }
+        }
+
+        return result;
+    }
+
+    static bool read_file_(const std::filesystem::path& path, std::string& content) {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    static bool write_file_(const std::filesystem::path& path, std::string_view content) {
+        std::ofstream file(path, std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return static_cast<bool>(file);
+    }
+
+public:
+    explicit latin_batch_engine(size_t thread_count = std::thread::hardware_concurrency())
+        : pool_(thread_count) {}
+
+    latin_result compile(std::string_view input) const {
+        auto chunk = compile_chunk_(trim_to_ender_(input));
+        return {std::move(chunk.output), std::move(chunk.rejected)};
+    }
+
+    std::vector<latin_result> compile_all(const std::vector<std::string_view>& inputs) {
+        std::vector<latin_result> results(inputs.size());
+
+        task_group group;
+        for (size_t i = 0; i < inputs.size(); i++) {
+            pool_.submit(group, [this, &inputs, &results, i] { results[i] = compile(inputs[i]); });
+        }
+        pool_.wait(group);
+
+        return results;
+    }
+
+    latin_result compile_chunked(std::string_view input, size_t chunk_size = 1 << 20) {
+        input            = trim_to_ender_(input);
+        chunk_size       = std::max<size_t>(chunk_size, 1);
+        auto chunk_count = (input.size() + chunk_size - 1) / chunk_size;
+
+        std::vector<latin_chunk> chunks(chunk_count);
+
+        task_group group;
+        for (size_t i = 0; i < chunk_count; i++) {
+            pool_.submit(group, [this, &chunks, input, chunk_size, i] {
+                auto offset = i * chunk_size;
+                chunks[i]   = compile_chunk_(input.substr(offset, chunk_size), offset);
+            });
+        }
+        pool_.wait(group);
+
+        std::vector<size_t> keep(chunk_count);
+        size_t pending = 0;
+        for (size_t i = chunk_count; i-- > 0;) {
+            auto deleted = std::min(pending, chunks[i].output.size());
+            keep[i]      = chunks[i].output.size() - deleted;
+            pending      = pending - deleted + chunks[i].unmatched;
+        }
+
+        std::vector<size_t> offsets(chunk_count + 1, 0);
+        for (size_t i = 0; i < chunk_count; i++) {
+            offsets[i + 1] = offsets[i] + keep[i];
+        }
+
+        latin_result result;
+        result.output.resize(offsets.back());
+        for (size_t i = 0; i < chunk_count; i++) {
+            pool_.submit(group, [&chunks, &keep, &offsets, &result, i] {
+                std::memcpy(result.output.data() + offsets[i], chunks[i].output.data(), keep[i]);
+            });
+        }
+        pool_.wait(group);
+
+        for (const auto& chunk : chunks) {
+            std::ranges::copy(chunk.rejected, std::back_inserter(result.rejected));
+        }
+        return result;
+    }
+
+    std::vector<latin_file_result> compile_files(const std::vector<std::filesystem::path>& inputs) {
+        std::vector<latin_file_result> results(inputs.size());
+
+        task_group group;
+        for (size_t i = 0; i < inputs.size(); i++) {
+            pool_.submit(group, [this, &inputs, &results, i] {
+                std::string content;
+                if (!read_file_(inputs[i], content)) {
+                    return;
+                }
+                auto compiled = compile(content);
+                auto output   = inputs[i];
+                output       += ".out";
+
+                results[i].done     = write_file_(output, compiled.output);
+                results[i].rejected = std::move(compiled.rejected);
+            });
+        }
+        pool_.wait(group);
+
+        return results;
+    }
+
+    latin_file_result compile_file_chunked(
+        const std::filesystem::path& input,
+        size_t chunk_size = 1 << 20
+    ) {
+        std::string content;
+        if (!read_file_(input, content)) {
+            return {};
+        }
+        auto compiled = compile_chunked(content, chunk_size);
+        auto output   = input;
+        output       += ".out";
+        return {write_file_(output, compiled.output), std::move(compiled.rejected)};
+    }
+};
+
+#endif  // GUAP_ALGO_LATIN_BATCH_H
@@ -3,70 +3,153 @@
 #ifndef GUAP_ALGO_LATIN_SEQUENCE_H
 #define GUAP_ALGO_LATIN_SEQUENCE_H
 
-#include <iostream>
+#include <vector>
 
+#include "persistent_stack.h"
 #include "two_linked_list.h"
 
 inline bool is_latin_letter(char letter) {
     return ('A' <= letter && letter <= 'Z') || ('a' <= letter && letter <= 'z');
 }
 
+enum class add_status {
+    added,
+    invalid_letter,
+    completed,
+};
+
 struct latin_sequence {
 private:
-    two_linked_list<char> char_list_;
-    char remover_ = '@';
-    char ender_   = '.';
+    struct entry final {
+        char letter;
+        persistent_stack<char> compiled;
+    };
+
+    using version = persistent_stack<entry>;
+
+    std::vector<version> journal_ = {version{}};
+    size_t current_               = 0;
+    char remover_                 = '@';
+    char ender_                   = '.';
+
+    const version& head_() const {
+        return journal_[current_];
+    }
+
+    persistent_stack<char> apply_(const version& base, char letter) const {
+        auto compiled = base.is_empty() ? persistent_stack<char>{} : base.back().compiled;
+        if (letter == remover_) {
+            return compiled.pop_back();
+        }
+        return compiled.push_back(letter);
+    }
+
+    version push_(const version& base, char letter) const {
+        return base.push_back({letter, apply_(base, letter)});
+    }
+
+    void commit_(version next) {
+        journal_.resize(current_ + 1);
+        journal_.push_back(std::move(next));
+        current_++;
+    }
 
 public:
     latin_sequence() = default;
 
-    void add(char letter) {
+    add_status add(char letter) {
         if (!is_latin_letter(letter) && letter != remover_ && letter != ender_) {
-            std::cout << "Недопустимый символ: " << letter << "\n";
-            return;
+            return add_status::invalid_letter;
         }
 
         if (is_completed()) {
-            std::cout << "Последовательность уже завершена.\n";
-            return;
+            return add_status::completed;
         }
 
-        char_list_.push_back(letter);
+        commit_(push_(head_(), letter));
+        return add_status::added;
     }
 
-    bool is_empty() {
-        return char_list_.is_empty();
+    bool is_empty() const {
+        return head_().is_empty();
     }
 
     void remove_last() {
-        char_list_.pop_back();
+        if (is_empty()) {
+            return;
+        }
+        commit_(head_().pop_back());
     }
 
     void remove_at(int index) {
-        char_list_.pop_at(index);
+        if (index < 0 || static_cast<size_t>(index) >= head_().size()) {
+            return;
+        }
+
+        std::vector<char> suffix;
+        auto base = head_();
+        while (base.size() > static_cast<size_t>(index) + 1) {
+            suffix.push_back(base.back().letter);
+            base = base.pop_back();
+        }
+        base = base.pop_back();
+
+        for (auto it = suffix.rbegin(); it != suffix.rend(); ++it) {
+            base = push_(base, *it);
+        }
+        commit_(std::move(base));
     }
 
-    bool is_completed() {
-        return !char_list_.is_empty() && char_list_.back() == ender_;
+    bool is_completed() const {
+        return !is_empty() && head_().back().letter == ender_;
     }
 
-    two_linked_list<char> list() {
-        return char_list_;
+    bool can_undo() const {
+        return current_ > 0;
     }
 
-    two_linked_list<char> compile() {
-        two_linked_list<char> result;
+    bool can_redo() const {
+        return current_ + 1 < journal_.size();
+    }
 
-        for (char v : char_list_) {
-            if (v == remover_) {
-                result.pop_back();
-            } else {
-                result.push_back(v);
-            }
+    void undo() {
+        if (can_undo()) {
+            current_--;
         }
+    }
+
+    void redo() {
+        if (can_redo()) {
+            current_++;
+        }
+    }
+
+    size_t version_count() const {
+        return journal_.size();
+    }
+
+    size_t current_version() const {
+        return current_;
+    }
 
+    two_linked_list<char> list() const {
+        two_linked_list<char> result;
+        for (const auto& it : head_().values()) {
+            result.push_back(it.letter);
+        }
         return result;
     }
+
+    persistent_stack<char> compile_at(size_t version_index) const {
+        if (version_index >= journal_.size() || journal_[version_index].is_empty()) {
+            return {};
+        }
+        return journal_[version_index].back().compiled;
+    }
+
+    persistent_stack<char> compile() const {
+        return compile_at(current_);
+    }
 };
 
 #endif  // GUAP_ALGO_LATIN_SEQUENCE_H
@@ -3,45 +3,44 @@
 #ifndef GUAP_ALGO_LATIN_SEQUENCE_MENU_H
 #define GUAP_ALGO_LATIN_SEQUENCE_MENU_H
 
+#include <console.h>
 #include <latin_sequence.h>
 
-#include <iostream>
+#include <cstdio>
 #include <optional>
 
 struct latin_sequence_menu {
     latin_sequence seq;
+    console io;
 
-    void print_menu() {
-        std::cout
-            << "a. Добавить элемент\n"
-            << "d. Удалить элемент\n"
-            << "p. Показать последовательность\n"
-            << "c. Сформировать итоговую последовательность\n"
-            << "q. Выход\n"
-            << "h. Показать меню\n\n"
-            << "Доп. справка:\n"
-            << "Спец. символ удаления предыдущего символа - '@'\n"
-            << "Спец. символ завершения последовательности - '.'\n\n";
-    }
+    explicit latin_sequence_menu(std::FILE* input = stdin, bool interactive = true)
+        : io(input, interactive) {}
 
-    template <typename T>
-    std::optional<T> strict_scan() {
-        T value;
-        std::cin >> value;
-        if (std::cin.fail()) {
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Ошибка ввода. Попробуйте снова.\n";
-            return {};
+    void print_menu() {
+        if (!io.is_interactive()) {
+            return;
         }
-        return {value};
+
+        io.out.write(
+            "a. Добавить элемент\n"
+            "d. Удалить элемент\n"
+            "p. Показать последовательность\n"
+            "c. Сформировать итоговую последовательность\n"
+            "u. Отменить последнее изменение\n"
+            "r. Повторить отменённое изменение\n"
+            "q. Выход\n"
+            "h. Показать меню\n\n"
+            "Доп. справка:\n"
+            "Спец. символ удаления предыдущего символа - '@'\n"
+            "Спец. символ завершения последовательности - '.'\n\n"
+        );
     }
 
     char request_choice() {
         std::optional<char> choice;
         while (!choice.has_value()) {
-            std::cout << ": ";
-            choice = strict_scan<char>();
+            io.prompt(": ");
+            choice = io.scan<char>();
             if (!choice.has_value()) {
                 print_menu();
             }
@@ -52,18 +51,29 @@ struct latin_sequence_menu {
     void add_letter() {
         std::optional<char> letter;
         while (!letter.has_value()) {
-            std::cout << "Введите латинскую букву (или '@', '.')\n> ";
-            letter = strict_scan<char>();
+            io.prompt("Введите латинскую букву (или '@', '.')\n> ");
+            letter = io.scan<char>();
+        }
+        switch (seq.add(letter.value())) {
+            case add_status::invalid_letter:
+                io.out.println("Недопустимый символ: {}", letter.value());
+                break;
+
+            case add_status::completed:
+                io.out.println("Последовательность уже завершена.");
+                break;
+
+            case add_status::added:
+                break;
         }
-        seq.add(letter.value());
         print_seq();
     }
 
     void remove_letter() {
         std::optional<int> index;
         while (!index.has_value()) {
-            std::cout << "Введите индекс для удаления (или -1 для удаления последнего символа)\n> ";
-            index = strict_scan<int>();
+            io.prompt("Введите индекс для удаления (или -1 для удаления последнего символа)\n> ");
+            index = io.scan<int>();
         }
         if (index == -1) {
             seq.remove_last();
@@ -75,62 +85,92 @@ struct latin_sequence_menu {
 
     void print_seq() {
         if (seq.is_empty()) {
-            std::cout << "Последовательность пуста.\n";
+            io.out.println("Последовательность пуста.");
             return;
         }
 
-        std::cout << "Последовательность: ";
+        io.out.write("Последовательность: ");
         for (char c : seq.list()) {
-            std::cout << c;
+            io.out.print("{}", c);
         }
-        std::cout << "\n";
+        io.out.println();
     }
 
     void compile_seq() {
         if (!seq.is_completed()) {
-            std::cout << "Последовательность не завершена. Добавьте '.' в конец.\n";
+            io.out.println("Последовательность не завершена. Добавьте '.' в конец.");
             return;
         }
-        std::cout << "Преобразованная последовательность: ";
-        for (char letter : seq.compile()) {
-            std::cout << letter;
+        io.out.write("Преобразованная последовательность: ");
+        for (char letter : seq.compile().values()) {
+            io.out.print("{}", letter);
         }
-        std::cout << "\n";
+        io.out.println();
     }
 
-    int run() {
-        print_menu();
-
-        while (true) {
-            switch (request_choice()) {
-                case 'q':
-                    return 0;
-
-                case 'a':
-                    add_letter();
-                    break;
-
-                case 'd':
-                    remove_letter();
-                    break;
-
-                case 'p':
-                    print_seq();
-                    break;
-
-                case 'c':
-                    compile_seq();
-                    break;
+    void undo_edit() {
+        if (!seq.can_undo()) {
+            io.out.println("Нечего отменять.");
+            return;
+        }
+        seq.undo();
+        print_seq();
+    }
 
-                case 'h':
-                    print_menu();
-                    break;
+    void redo_edit() {
+        if (!seq.can_redo()) {
+            io.out.println("Нечего повторять.");
+            return;
+        }
+        seq.redo();
+        print_seq();
+    }
 
-                default:
-                    std::cout << "Некорректный выбор. Попробуйте снова.\n";
-                    print_menu();
-                    break;
+    int run() {
+        try {
+            print_menu();
+
+            while (true) {
+                switch (request_choice()) {
+                    case 'q':
+                        return 0;
+
+                    case 'a':
+                        add_letter();
+                        break;
+
+                    case 'd':
+                        remove_letter();
+                        break;
+
+                    case 'p':
+                        print_seq();
+                        break;
+
+                    case 'c':
+                        compile_seq();
+                        break;
+
+                    case 'u':
+                        undo_edit();
+                        break;
+
+                    case 'r':
+                        redo_edit();
+                        break;
+
+                    case 'h':
+                        print_menu();
+                        break;
+
+                    default:
+                        io.out.println("Некорректный выбор. Попробуйте снова.");
+                        print_menu();
+                        break;
+                }
             }
+        } catch (const end_of_input&) {
+            return 0;
         }
     }
 };
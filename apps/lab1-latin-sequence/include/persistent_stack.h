@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef GUAP_ALGO_PERSISTENT_STACK_H
+#define GUAP_ALGO_PERSISTENT_STACK_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+template <typename T>
+struct persistent_stack final {
+private:
+    struct node final {
+        T value;
+        std::shared_ptr<node> prev;
+        size_t size;
+    };
+
+    std::shared_ptr<node> top_;
+
+    explicit persistent_stack(std::shared_ptr<node> top)
+        : top_(std::move(top)) {}
+
+public:
+    persistent_stack() = default;
+
+    persistent_stack(const persistent_stack&)            = default;
+    persistent_stack& operator=(const persistent_stack&) = default;
+    persistent_stack(persistent_stack&&) noexcept            = default;
+    persistent_stack& operator=(persistent_stack&&) noexcept = default;
+
+    ~persistent_stack() {
+        auto current = std::move(top_);
+        while (current && current.use_count() == 1) {
+            current = std::move(current->prev);
+        }
+    }
+
+    bool is_empty() const {
+        return top_ == nullptr;
+    }
+
+    size_t size() const {
+        return top_ ? top_->size : 0;
+    }
+
+    const T& back() const {
+        return top_->value;
+    }
+
+    persistent_stack push_back(const T& value) const {
+        return persistent_stack{std::make_shared<node>(value, top_, size() + 1)};
+    }
+
+    persistent_stack pop_back() const {
+        if (!top_) {
+            return {};
+        }
+        return persistent_stack{top_->prev};
+    }
+
+    std::vector<T> values() const {
+        std::vector<T> result(size());
+        auto index = result.size();
+        for (auto* current = top_.get(); current; current = current->prev.get()) {
+            result[--index] = current->value;
+        }
+        return result;
+    }
+};
+
+#endif  // GUAP_ALGO_PERSISTENT_STACK_H
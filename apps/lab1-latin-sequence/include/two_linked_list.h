@@ -1,167 +1,90 @@
 #pragma once
 
-#ifndef GUAP_ALGO_LIST_H
-#define GUAP_ALGO_LIST_H
-
-template <typename T>
-struct node final {
-    T value;
-    node* next = nullptr;
-    node* prev = nullptr;
-};
+#ifndef GUAP_ALGO_TWO_LINKED_LIST_H
+#define GUAP_ALGO_TWO_LINKED_LIST_H
+
+#include <functional>
+#include <memory>
+
+#include "intrusive_list.h"
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 struct two_linked_list final {
 private:
-    node<T>* head_ = nullptr;
-    node<T>* tail_ = nullptr;
-    int size_      = 0;
-
-    void remove_node_(node<T>* target) {
-        if (target->prev) {
-            auto* prev = target->prev;
-            prev->next = target->next;
-        }
-        if (target->next) {
-            auto* next = target->next;
-            next->prev = target->prev;
-        }
-        if (target == head_) {
-            head_ = target->next;
-        }
-        if (target == tail_) {
-            tail_ = target->prev;
-        }
-
-        delete target;
-    }
+    struct node final {
+        T value;
+        list_hook<node> hook;
+    };
 
-public:
-    two_linked_list() = default;
-    ~two_linked_list() {
-        while (head_) {
-            pop_back();
-        }
-    }
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+    using list_type      = intrusive_list<node, &node::hook, node_allocator>;
 
-    two_linked_list& operator=(const two_linked_list& rhs) {
-        if (this == &rhs) {
-            return *this;
-        }
+    list_type nodes_;
 
-        clear();
-        for (T value : rhs) {
-            push_back(value);
-        }
+public:
+    constexpr two_linked_list() = default;
+    explicit constexpr two_linked_list(const Allocator& alloc)
+        : nodes_(node_allocator(alloc)) {}
 
-        return *this;
+    constexpr bool is_empty() const {
+        return nodes_.is_empty();
     }
-    two_linked_list(const two_linked_list& rhs) {
-        *this = rhs;
-    }
-
-    two_linked_list& operator=(two_linked_list&& rhs) noexcept {
-        if (this == &rhs) {
-            return *this;
-        }
-
-        std::swap(head_, rhs.head_);
-        std::swap(tail_, rhs.tail_);
-        std::swap(size_, rhs.size_);
 
-        return *this;
-    }
-    two_linked_list(two_linked_list&& rhs) noexcept {
-        *this = std::move(rhs);
+    constexpr size_t size() const {
+        return nodes_.size();
     }
 
-    bool is_empty() const {
-        return size_ == 0;
+    constexpr T back() const {
+        return nodes_.back().value;
     }
 
-    T back() const {
-        return tail_->value;
+    constexpr void push_back(const T& value) {
+        nodes_.emplace_back(value);
     }
 
-    void push_back(const T& value) {
-        auto* new_node = new node<T>{value, nullptr, tail_};
-        if (tail_) {
-            tail_->next = new_node;
-        } else {
-            head_ = new_node;
-        }
-        tail_ = new_node;
-        size_++;
+    constexpr void pop_back() {
+        nodes_.pop_back();
     }
 
-    void pop_back() {
-        if (!tail_) {
-            return;
-        }
-
-        auto* to_delete = tail_;
-        tail_           = tail_->prev;
-        if (tail_) {
-            tail_->next = nullptr;
-        } else {
-            head_ = nullptr;
-        }
-        delete to_delete;
-        size_--;
+    constexpr void pop_at(int index) {
+        nodes_.pop_at(index);
     }
 
-    void pop_at(int index) {
-        if (index < 0 || index >= size_) {
-            return;
-        }
-
-        auto* current     = head_;
-        int current_index = 0;
-        while (current_index != index) {
-            current = current->next;
-            current_index++;
-        }
-
-        remove_node_(current);
-        size_--;
+    constexpr void clear() {
+        nodes_.clear();
     }
 
-    void clear() {
-        while (head_) {
-            pop_back();
-        }
+    template <class Comp = std::ranges::less, class Proj = std::identity>
+    constexpr void sort(Comp comp = {}, Proj proj = {}) {
+        nodes_.sort(comp, [&proj](const node& n) -> decltype(auto) {
+            return std::invoke(proj, n.value);
+        });
     }
 
     struct iterator final {
-        node<T>* current;
+        typename list_type::const_iterator current;
 
-        iterator& operator++() {
-            if (current) {
-                current = current->next;
-            }
+        constexpr iterator& operator++() {
+            ++current;
             return *this;
         }
 
-        T& operator*() {
+        constexpr const T& operator*() const {
             return current->value;
         }
 
-        bool operator==(const iterator& rhs) {
+        constexpr bool operator==(const iterator& rhs) const {
             return current == rhs.current;
         }
-
-        bool operator!=(const iterator& rhs) {
-            return !(*this == rhs);
-        }
     };
 
-    iterator begin() const {
-        return {head_};
+    constexpr iterator begin() const {
+        return {nodes_.begin()};
     }
 
-    iterator end() const {
-        return {nullptr};
+    constexpr iterator end() const {
+        return {nodes_.end()};
     }
 };
 
-#endif  // GUAP_ALGO_LIST_H
+#endif  // GUAP_ALGO_TWO_LINKED_LIST_H
@@ -1,5 +1,52 @@
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "console.h"
+#include "latin_batch.h"
 #include "latin_sequence_menu.h"
 
-int main() {
-    return latin_sequence_menu{}.run();
+int run_batch(int argc, char** argv) {
+    std::vector<std::filesystem::path> inputs(argv + 1, argv + argc);
+
+    latin_batch_engine engine;
+    std::vector<latin_file_result> results;
+    if (inputs.size() == 1) {
+        results.push_back(engine.compile_file_chunked(inputs.front()));
+    } else {
+        results = engine.compile_files(inputs);
+    }
+
+    console_writer out;
+    int failed = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        for (const auto& it : results[i].rejected) {
+            out.println(
+                "{}:{}: Недопустимый символ: {}",
+                inputs[i].string(),
+                it.offset,
+                it.letter
+            );
+        }
+        if (!results[i].done) {
+            out.println("Не удалось обработать файл: {}", inputs[i].string());
+            failed++;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::string_view(argv[1]) == "--script") {
+        auto input = open_script(argv[2]);
+        if (!input) {
+            console_writer().println("Не удалось открыть файл сценария.");
+            return 1;
+        }
+        return latin_sequence_menu(input, false).run();
+    }
+    if (argc > 1) {
+        return run_batch(argc, argv);
+    }
+    return latin_sequence_menu().run();
 }
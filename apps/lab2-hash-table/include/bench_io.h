@@ -0,0 +1,109 @@
+#pragma once
+
+#ifndef GUAP_ALGO_BENCH_IO_H
+#define GUAP_ALGO_BENCH_IO_H
+
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+template <typename T>
+    requires std::integral<T> || std::floating_point<T>
+std::optional<T> parse_number(std::string_view text) {
+    T value{};
+
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || error != std::errc{} || end != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    if constexpr (std::floating_point<T>) {
+        if (!std::isfinite(value)) {
+            return std::nullopt;
+        }
+    }
+    return value;
+}
+
+template <typename T>
+bool parse_value(std::string_view text, T& value) {
+    auto parsed = parse_number<T>(text);
+    if (parsed.has_value()) {
+        value = parsed.value();
+    }
+    return parsed.has_value();
+}
+
+template <typename T>
+bool parse_list(std::string_view text, std::vector<T>& values, size_t count = 0) {
+    std::vector<T> parsed;
+    for (;;) {
+        auto comma = text.find(',');
+        auto value = parse_number<T>(text.substr(0, comma));
+        if (!value.has_value()) {
+            return false;
+        }
+
+        parsed.push_back(value.value());
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        text = text.substr(comma + 1);
+    }
+
+    if (count > 0 && parsed.size() != count) {
+        return false;
+    }
+    values = std::move(parsed);
+    return true;
+}
+
+template <typename Handler>
+bool parse_options(int argc, char** argv, Handler&& handler) {
+    if (argc % 2 == 0) {
+        std::println("Не указано значение для {}", argv[argc - 1]);
+        return false;
+    }
+
+    for (int i = 1; i < argc; i += 2) {
+        std::string_view name  = argv[i];
+        std::string_view value = argv[i + 1];
+
+        if (!handler(name, value)) {
+            std::println("Некорректный аргумент {} {}", name, value);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Result, typename Format>
+bool write_json(
+    const std::string& path,
+    std::string_view config,
+    const std::vector<Result>& results,
+    Format&& format
+) {
+    std::ofstream file(path, std::ios::out);
+    if (!file.is_open()) {
+        std::println("Не удалось создать файл {}", path);
+        return false;
+    }
+
+    file << std::format("{{\n  \"config\": {},\n  \"results\": [\n", config);
+    for (size_t i = 0; i < results.size(); i++) {
+        file << std::format("    {}{}\n", format(results[i]), i + 1 < results.size() ? "," : "");
+    }
+    file << "  ]\n}\n";
+    return file.good();
+}
+
+#endif  // GUAP_ALGO_BENCH_IO_H
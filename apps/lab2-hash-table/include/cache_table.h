@@ -0,0 +1,312 @@
+#pragma once
+
+#ifndef GUAP_ALGO_CACHE_TABLE_H
+#define GUAP_ALGO_CACHE_TABLE_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "hash_table.h"
+#include "key_hash.h"
+
+enum class eviction_policy {
+    clock,
+    segmented_lru,
+};
+
+struct cache_config final {
+    size_t max_items       = 0;
+    size_t max_bytes       = 0;
+    eviction_policy policy = eviction_policy::clock;
+    double protected_share = 0.8;
+};
+
+struct cache_stats final {
+    std::uint64_t hits        = 0;
+    std::uint64_t misses      = 0;
+    std::uint64_t expirations = 0;
+    std::uint64_t evictions   = 0;
+    std::uint64_t promotions  = 0;
+    std::uint64_t demotions   = 0;
+
+    size_t items           = 0;
+    size_t bytes           = 0;
+    size_t protected_items = 0;
+    size_t metadata_bytes  = 0;
+
+    double hit_ratio() const {
+        auto lookups = hits + misses;
+        return lookups ? static_cast<double>(hits) / lookups : 0;
+    }
+};
+
+template <
+    typename K,
+    typename V,
+    typename Hash     = key_hash<K>,
+    typename KeyEqual = std::equal_to<>,
+    typename Clock    = std::chrono::steady_clock>
+struct basic_cache_table final {
+    using key_type    = K;
+    using mapped_type = V;
+    using clock_type  = Clock;
+    using duration    = typename Clock::duration;
+    using time_point  = typename Clock::time_point;
+
+private:
+    static constexpr time_point never_ = time_point::max();
+
+    static constexpr std::uint8_t slot_used       = 1;
+    static constexpr std::uint8_t slot_referenced = 2;
+    static constexpr std::uint8_t slot_protected  = 4;
+
+    struct entry final {
+        V value;
+        std::uint32_t slot = 0;
+        time_point expires = never_;
+    };
+
+    using table_type = basic_hash_table<K, entry, Hash, KeyEqual>;
+
+    table_type table_;
+    cache_config config_;
+
+    std::vector<K> keys_;
+    std::vector<std::uint8_t> meta_;
+    std::vector<std::uint32_t> charges_;
+    std::vector<std::uint32_t> free_;
+
+    size_t hand_            = 0;
+    size_t bytes_           = 0;
+    size_t protected_count_ = 0;
+
+    std::uint64_t hits_        = 0;
+    std::uint64_t misses_      = 0;
+    std::uint64_t expirations_ = 0;
+    std::uint64_t evictions_   = 0;
+    std::uint64_t promotions_  = 0;
+    std::uint64_t demotions_   = 0;
+
+    bool fits_(size_t items, size_t bytes) const {
+        return (config_.max_items == 0 || table_.size() + items <= config_.max_items) &&
+               (config_.max_bytes == 0 || bytes_ + bytes <= config_.max_bytes);
+    }
+
+    size_t protected_limit_() const {
+        auto items = config_.max_items ? config_.max_items : table_.size();
+        return static_cast<size_t>(config_.protected_share * static_cast<double>(items));
+    }
+
+    static bool expired_(const entry& e) {
+        return e.expires != never_ && e.expires <= Clock::now();
+    }
+
+    static time_point deadline_(duration ttl) {
+        return ttl > duration::zero() ? Clock::now() + ttl : never_;
+    }
+
+    std::uint32_t acquire_slot_(const K& key, std::uint32_t charge) {
+        std::uint32_t slot = 0;
+        if (free_.empty()) {
+            slot = static_cast<std::uint32_t>(meta_.size());
+            keys_.push_back(key);
+            meta_.push_back(slot_used);
+            charges_.push_back(charge);
+        } else {
+            slot = free_.back();
+            free_.pop_back();
+            keys_[slot]    = key;
+            meta_[slot]    = slot_used;
+            charges_[slot] = charge;
+        }
+        bytes_ += charge;
+        return slot;
+    }
+
+    void release_slot_(std::uint32_t slot) {
+        if (meta_[slot] & slot_protected) {
+            protected_count_--;
+        }
+        bytes_      -= charges_[slot];
+        meta_[slot]  = 0;
+        free_.push_back(slot);
+    }
+
+    void drop_(std::uint32_t slot) {
+        table_.remove(keys_[slot]);
+        release_slot_(slot);
+    }
+
+    void evict_one_() {
+        while (true) {
+            if (hand_ >= meta_.size()) {
+                hand_ = 0;
+            }
+
+            auto slot  = static_cast<std::uint32_t>(hand_++);
+            auto& meta = meta_[slot];
+            if (!(meta & slot_used)) {
+                continue;
+            }
+
+            if (meta & slot_referenced) {
+                meta &= ~slot_referenced;
+                if (config_.policy == eviction_policy::segmented_lru &&
+                    !(meta & slot_protected) && protected_count_ < protected_limit_()) {
+                    meta |= slot_protected;
+                    protected_count_++;
+                    promotions_++;
+                }
+                continue;
+            }
+            if (meta & slot_protected) {
+                meta &= ~slot_protected;
+                protected_count_--;
+                demotions_++;
+                continue;
+            }
+
+            drop_(slot);
+            evictions_++;
+            return;
+        }
+    }
+
+    void shrink_(size_t items, size_t bytes) {
+        while (table_.size() > 0 && !fits_(items, bytes)) {
+            evict_one_();
+        }
+    }
+
+public:
+    basic_cache_table() = default;
+
+    explicit basic_cache_table(cache_config config)
+        : config_(config) {
+        if (config_.max_items != 0) {
+            keys_.reserve(config_.max_items);
+            meta_.reserve(config_.max_items);
+            charges_.reserve(config_.max_items);
+        }
+    }
+
+    const cache_config& config() const {
+        return config_;
+    }
+
+    size_t size() const {
+        return table_.size();
+    }
+
+    size_t bytes() const {
+        return bytes_;
+    }
+
+    static constexpr size_t default_charge() {
+        return sizeof(typename table_type::item) + sizeof(K) + sizeof(std::uint32_t) + 1;
+    }
+
+    V* find(const K& key) {
+        auto* e = table_.find(key);
+        if (e == nullptr) {
+            misses_++;
+            return nullptr;
+        }
+        if (expired_(*e)) {
+            drop_(e->slot);
+            expirations_++;
+            misses_++;
+            return nullptr;
+        }
+
+        meta_[e->slot] |= slot_referenced;
+        hits_++;
+        return &e->value;
+    }
+
+    bool contains(const K& key) {
+        return find(key) != nullptr;
+    }
+
+    bool insert(const K& key, V value, duration ttl = duration::zero(), size_t charge = 0) {
+        charge = charge ? charge : default_charge();
+        if (charge > std::numeric_limits<std::uint32_t>::max() ||
+            (config_.max_bytes != 0 && charge > config_.max_bytes)) {
+            remove(key);
+            return false;
+        }
+
+        if (auto* e = table_.find(key)) {
+            e->value            = std::move(value);
+            e->expires          = deadline_(ttl);
+            bytes_             += charge - charges_[e->slot];
+            charges_[e->slot]   = static_cast<std::uint32_t>(charge);
+            meta_[e->slot]     |= slot_referenced;
+            shrink_(0, 0);
+            return true;
+        }
+
+        shrink_(1, charge);
+        auto slot = acquire_slot_(key, static_cast<std::uint32_t>(charge));
+        table_.insert(key, entry{std::move(value), slot, deadline_(ttl)});
+        return true;
+    }
+
+    bool remove(const K& key) {
+        auto* e = table_.find(key);
+        if (e == nullptr) {
+            return false;
+        }
+        drop_(e->slot);
+        return true;
+    }
+
+    void clear() {
+        table_.clear();
+        keys_.clear();
+        meta_.clear();
+        charges_.clear();
+        free_.clear();
+        hand_            = 0;
+        bytes_           = 0;
+        protected_count_ = 0;
+    }
+
+    void reset_stats() {
+        hits_        = 0;
+        misses_      = 0;
+        expirations_ = 0;
+        evictions_   = 0;
+        promotions_  = 0;
+        demotions_   = 0;
+    }
+
+    cache_stats stats() const {
+        cache_stats result;
+        result.hits            = hits_;
+        result.misses          = misses_;
+        result.expirations     = expirations_;
+        result.evictions       = evictions_;
+        result.promotions      = promotions_;
+        result.demotions       = demotions_;
+        result.items           = table_.size();
+        result.bytes           = bytes_;
+        result.protected_items = protected_count_;
+        result.metadata_bytes  = keys_.capacity() * sizeof(K) + meta_.capacity() +
+                                charges_.capacity() * sizeof(std::uint32_t) +
+                                free_.capacity() * sizeof(std::uint32_t);
+        return result;
+    }
+
+    const table_type& table() const {
+        return table_;
+    }
+};
+
+template <typename V>
+using cache_table = basic_cache_table<packed_key, V>;
+
+#endif  // GUAP_ALGO_CACHE_TABLE_H
@@ -0,0 +1,245 @@
+#pragma once
+
+#ifndef GUAP_ALGO_COW_HASH_TABLE_H
+#define GUAP_ALGO_COW_HASH_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "hash_table.h"
+#include "hash_table_stats.h"
+#include "key_hash.h"
+
+template <
+    typename K,
+    typename V,
+    typename Hash     = key_hash<K>,
+    typename KeyEqual = std::equal_to<>>
+struct cow_hash_table final {
+    using table_type = basic_hash_table<K, V, Hash, KeyEqual>;
+
+    static constexpr size_t bucket_count = table_type::bucket_count;
+
+    using key_type    = K;
+    using mapped_type = V;
+    using item        = typename table_type::item;
+    using bucket_type = typename table_type::bucket_type;
+
+private:
+    using bucket_ptr   = std::shared_ptr<bucket_type>;
+    using bucket_array = std::array<bucket_ptr, bucket_count>;
+
+    static inline const bucket_type empty_bucket_ = {};
+
+    template <typename Q>
+    static const item* find_in_(
+        const bucket_ptr& bucket,
+        const Q& key,
+        size_t hash,
+        const KeyEqual& equal,
+        size_t& probes
+    ) {
+        if (!bucket) {
+            return nullptr;
+        }
+        for (const auto& it : *bucket) {
+            probes++;
+            if (it.hash.matches(hash) && equal(it.key, key)) {
+                return &it;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    struct snapshot_view final {
+        static constexpr size_t bucket_count = cow_hash_table::bucket_count;
+
+        using key_type    = K;
+        using mapped_type = V;
+        using item        = typename cow_hash_table::item;
+        using bucket_type = typename cow_hash_table::bucket_type;
+
+    private:
+        friend cow_hash_table;
+
+        std::shared_ptr<const bucket_array> root_;
+        size_t size_ = 0;
+
+        [[no_unique_address]] Hash hash_      = {};
+        [[no_unique_address]] KeyEqual equal_ = {};
+
+        snapshot_view(std::shared_ptr<const bucket_array> root, size_t size)
+            : root_(std::move(root))
+            , size_(size) {}
+
+    public:
+        snapshot_view() = default;
+
+        size_t size() const {
+            return size_;
+        }
+
+        const bucket_type& bucket(size_t index) const {
+            if (!root_ || !(*root_)[index]) {
+                return empty_bucket_;
+            }
+            return *(*root_)[index];
+        }
+
+        template <typename Q = K>
+        const V* find(const Q& key) const {
+            if (!root_) {
+                return nullptr;
+            }
+
+            size_t probes = 0;
+            auto hash     = hash_(key);
+            auto* found   = find_in_((*root_)[hash % bucket_count], key, hash, equal_, probes);
+            return found ? &found->value : nullptr;
+        }
+
+        template <typename Q = K>
+        bool contains(const Q& key) const {
+            return find(key) != nullptr;
+        }
+    };
+
+private:
+    std::shared_ptr<bucket_array> root_ = std::make_shared<bucket_array>();
+    size_t size_                        = 0;
+
+    [[no_unique_address]] Hash hash_      = {};
+    [[no_unique_address]] KeyEqual equal_ = {};
+
+    [[no_unique_address]] mutable hash_table_counters counters_ = {};
+
+    mutable std::mutex mutex_;
+
+    template <typename T>
+    static bool is_exclusive_(const std::shared_ptr<T>& ptr) {
+        if (ptr.use_count() != 1) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    bucket_type& writable_bucket_(size_t index) {
+        if (!is_exclusive_(root_)) {
+            root_ = std::make_shared<bucket_array>(*root_);
+        }
+
+        auto& bucket = (*root_)[index];
+        if (!bucket) {
+            bucket = std::make_shared<bucket_type>();
+        } else if (!is_exclusive_(bucket)) {
+            bucket = std::make_shared<bucket_type>(*bucket);
+        }
+        return *bucket;
+    }
+
+public:
+    cow_hash_table() = default;
+
+    cow_hash_table(const cow_hash_table&)            = delete;
+    cow_hash_table& operator=(const cow_hash_table&) = delete;
+
+    size_t bucket_of(const K& key) const {
+        return hash_(key) % bucket_count;
+    }
+
+    size_t size() const {
+        std::lock_guard lock(mutex_);
+        return size_;
+    }
+
+    snapshot_view snapshot() const {
+        std::lock_guard lock(mutex_);
+        return {root_, size_};
+    }
+
+    void insert(const K& key, V value) {
+        auto hash  = hash_(key);
+        auto index = hash % bucket_count;
+
+        std::lock_guard lock(mutex_);
+
+        auto& bucket = writable_bucket_(index);
+        for (auto& it : bucket) {
+            if (it.hash.matches(hash) && equal_(it.key, key)) {
+                it.value = std::move(value);
+                return;
+            }
+        }
+
+        bucket.emplace_back(key, std::move(value)).hash.store(hash);
+        size_++;
+        counters_.record_insert(bucket.size() > 1);
+    }
+
+    template <typename Q = K>
+    std::optional<V> find(const Q& key) const {
+        auto hash = hash_(key);
+
+        std::lock_guard lock(mutex_);
+
+        size_t probes = 0;
+        auto* found   = find_in_((*root_)[hash % bucket_count], key, hash, equal_, probes);
+        counters_.record_lookup(probes, found != nullptr);
+        if (!found) {
+            return {};
+        }
+        return found->value;
+    }
+
+    template <typename Q = K>
+    bool contains(const Q& key) const {
+        return find(key).has_value();
+    }
+
+    template <typename Q = K>
+    void remove(const Q& key) {
+        auto hash  = hash_(key);
+        auto index = hash % bucket_count;
+
+        std::lock_guard lock(mutex_);
+
+        size_t probes = 0;
+        if (!find_in_((*root_)[index], key, hash, equal_, probes)) {
+            return;
+        }
+
+        auto& bucket = writable_bucket_(index);
+        for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+            if (it->hash.matches(hash) && equal_(it->key, key)) {
+                bucket.erase(it);
+                size_--;
+                counters_.record_remove();
+                return;
+            }
+        }
+    }
+
+    hash_table_stats stats() const {
+        auto view = snapshot();
+
+        hash_table_stats result;
+        counters_.fill(result);
+
+        result.items = view.size();
+        result.occupancy.resize(bucket_count);
+        for (size_t i = 0; i < bucket_count; i++) {
+            result.occupancy[i]  = view.bucket(i).size();
+            result.longest_chain = std::max(result.longest_chain, view.bucket(i).size());
+        }
+        return result;
+    }
+};
+
+#endif  // GUAP_ALGO_COW_HASH_TABLE_H
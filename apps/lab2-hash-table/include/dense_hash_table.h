@@ -0,0 +1,283 @@
+#pragma once
+
+#ifndef GUAP_ALGO_DENSE_HASH_TABLE_H
+#define GUAP_ALGO_DENSE_HASH_TABLE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "hash_key.h"
+#include "hash_table_stats.h"
+#include "key_hash.h"
+#include "packed_key.h"
+
+template <
+    typename K,
+    typename V,
+    typename Hash     = key_hash<K>,
+    typename KeyEqual = std::equal_to<>>
+struct basic_dense_hash_table final {
+    static constexpr bool caches_hash = caches_hash_v<K>;
+
+    using key_type    = K;
+    using mapped_type = V;
+    using hasher      = Hash;
+    using key_equal   = KeyEqual;
+
+    struct entry {
+        key_type key;
+        V value;
+        [[no_unique_address]] cached_hash<caches_hash> hash;
+    };
+
+    using const_iterator = typename std::vector<entry>::const_iterator;
+
+private:
+    static constexpr size_t npos_      = static_cast<size_t>(-1);
+    static constexpr size_t min_slots_ = 16;
+
+    std::vector<entry> entries_;
+    std::vector<std::uint32_t> slots_;
+    unsigned shift_ = 64;
+
+    [[no_unique_address]] Hash hash_      = {};
+    [[no_unique_address]] KeyEqual equal_ = {};
+
+    [[no_unique_address]] mutable hash_table_counters counters_ = {};
+
+    constexpr size_t mask_() const {
+        return slots_.size() - 1;
+    }
+
+    constexpr size_t hash_of_(const entry& e) const {
+        if constexpr (caches_hash) {
+            return e.hash.value;
+        } else {
+            return hash_(e.key);
+        }
+    }
+
+    constexpr size_t home_(size_t hash) const {
+        auto h = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h >> shift_);
+    }
+
+    constexpr size_t find_slot_(const K& key, size_t hash, bool lookup = false) const {
+        if (slots_.empty()) {
+            if !consteval {
+                if (lookup) {
+                    counters_.record_lookup(0, false);
+                }
+            }
+            return npos_;
+        }
+
+        size_t probes = 0;
+        for (auto slot = home_(hash);; slot = (slot + 1) & mask_()) {
+            auto index = slots_[slot];
+            if (index == 0) {
+                if !consteval {
+                    if (lookup) {
+                        counters_.record_lookup(probes, false);
+                    }
+                }
+                return npos_;
+            }
+
+            probes++;
+            const auto& e = entries_[index - 1];
+            if (e.hash.matches(hash) && equal_(e.key, key)) {
+                if !consteval {
+                    if (lookup) {
+                        counters_.record_lookup(probes, true);
+                    }
+                }
+                return slot;
+            }
+        }
+    }
+
+    constexpr size_t slot_of_index_(size_t index) const {
+        for (auto slot = home_(hash_of_(entries_[index]));; slot = (slot + 1) & mask_()) {
+            if (slots_[slot] == index + 1) {
+                return slot;
+            }
+        }
+    }
+
+    constexpr void place_(size_t index, size_t hash) {
+        auto slot = home_(hash);
+        while (slots_[slot] != 0) {
+            slot = (slot + 1) & mask_();
+        }
+        slots_[slot] = static_cast<std::uint32_t>(index + 1);
+    }
+
+    constexpr void rehash_(size_t slot_count) {
+        slots_.assign(slot_count, 0);
+        shift_ = 64 - static_cast<unsigned>(std::countr_zero(slot_count));
+        for (size_t i = 0; i < entries_.size(); i++) {
+            place_(i, hash_of_(entries_[i]));
+        }
+    }
+
+    constexpr void vacate_(size_t hole) {
+        for (auto slot = (hole + 1) & mask_(); slots_[slot] != 0; slot = (slot + 1) & mask_()) {
+            auto home = home_(hash_of_(entries_[slots_[slot] - 1]));
+            if (((slot - home) & mask_()) >= ((slot - hole) & mask_())) {
+                slots_[hole] = slots_[slot];
+                hole         = slot;
+            }
+        }
+        slots_[hole] = 0;
+    }
+
+    constexpr V& emplace_(const K& key, V value, size_t hash) {
+        if ((entries_.size() + 1) * 4 > slots_.size() * 3) {
+            rehash_(std::max(min_slots_, 2 * slots_.size()));
+        }
+
+        auto& e = entries_.emplace_back(key, std::move(value));
+        e.hash.store(hash);
+        place_(entries_.size() - 1, hash);
+
+        if !consteval {
+            counters_.record_insert(false);
+        }
+        return e.value;
+    }
+
+    constexpr void erase_swap_(size_t slot) {
+        auto index = slots_[slot] - 1;
+        auto last  = entries_.size() - 1;
+        vacate_(slot);
+
+        if (index != last) {
+            slots_[slot_of_index_(last)] = static_cast<std::uint32_t>(index + 1);
+            entries_[index]              = std::move(entries_[last]);
+        }
+        entries_.pop_back();
+
+        if !consteval {
+            counters_.record_remove();
+        }
+    }
+
+public:
+    constexpr size_t size() const {
+        return entries_.size();
+    }
+
+    constexpr bool is_empty() const {
+        return entries_.empty();
+    }
+
+    constexpr void reserve(size_t count) {
+        entries_.reserve(count);
+        auto slot_count = std::bit_ceil(std::max(min_slots_, (count * 4 + 2) / 3));
+        if (slot_count > slots_.size()) {
+            rehash_(slot_count);
+        }
+    }
+
+    constexpr V& operator[](const K& key) {
+        auto hash = hash_(key);
+        if (auto slot = find_slot_(key, hash); slot != npos_) {
+            return entries_[slots_[slot] - 1].value;
+        }
+        return emplace_(key, V{}, hash);
+    }
+
+    constexpr const V& operator[](const K& key) const {
+        if (const auto* value = find(key)) {
+            return *value;
+        }
+        throw std::out_of_range("key not found");
+    }
+
+    constexpr void insert(const K& key, V value) {
+        auto hash = hash_(key);
+        if (auto slot = find_slot_(key, hash); slot != npos_) {
+            entries_[slots_[slot] - 1].value = std::move(value);
+            return;
+        }
+        emplace_(key, std::move(value), hash);
+    }
+
+    constexpr bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    constexpr V* find(const K& key) {
+        return const_cast<V*>(std::as_const(*this).find(key));
+    }
+
+    constexpr const V* find(const K& key) const {
+        auto slot = find_slot_(key, hash_(key), true);
+        return slot != npos_ ? &entries_[slots_[slot] - 1].value : nullptr;
+    }
+
+    constexpr void remove(const K& key) {
+        if (auto slot = find_slot_(key, hash_(key)); slot != npos_) {
+            erase_swap_(slot);
+        }
+    }
+
+    constexpr void remove_ordered(const K& key) {
+        auto slot = find_slot_(key, hash_(key));
+        if (slot == npos_) {
+            return;
+        }
+
+        auto index = slots_[slot] - 1;
+        vacate_(slot);
+        entries_.erase(entries_.begin() + index);
+        for (auto& s : slots_) {
+            s -= s > index + 1;
+        }
+
+        if !consteval {
+            counters_.record_remove();
+        }
+    }
+
+    constexpr void clear() {
+        entries_.clear();
+        std::ranges::fill(slots_, 0);
+    }
+
+    constexpr std::span<const entry> entries() const {
+        return entries_;
+    }
+
+    constexpr const_iterator begin() const {
+        return entries_.begin();
+    }
+
+    constexpr const_iterator end() const {
+        return entries_.end();
+    }
+
+    hash_table_stats stats() const {
+        hash_table_stats result;
+        counters_.fill(result);
+        result.items = entries_.size();
+        return result;
+    }
+
+    size_t memory_bytes() const {
+        return sizeof(*this) + entries_.capacity() * sizeof(entry) +
+               slots_.capacity() * sizeof(std::uint32_t);
+    }
+};
+
+template <typename V>
+using dense_hash_table = basic_dense_hash_table<packed_key, V>;
+
+#endif  // GUAP_ALGO_DENSE_HASH_TABLE_H
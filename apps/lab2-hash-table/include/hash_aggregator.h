@@ -0,0 +1,287 @@
+#pragma once
+
+#ifndef GUAP_ALGO_HASH_AGGREGATOR_H
+#define GUAP_ALGO_HASH_AGGREGATOR_H
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "hash_table.h"
+#include "key_hash.h"
+#include "work_stealing_pool.h"
+
+template <typename R, typename T>
+concept aggregate_reducer =
+    requires(const R& reducer, typename R::value_type& acc, const T& value) {
+        { reducer.init(value) } -> std::convertible_to<typename R::value_type>;
+        reducer.update(acc, value);
+    };
+
+struct count_reducer final {
+    using value_type = std::uint64_t;
+
+    template <typename T>
+    constexpr value_type init(const T&) const {
+        return 1;
+    }
+
+    template <typename T>
+    constexpr void update(value_type& acc, const T&) const {
+        acc++;
+    }
+};
+
+template <typename T>
+struct sum_reducer final {
+    using value_type = T;
+
+    template <typename U>
+    constexpr value_type init(const U& value) const {
+        return static_cast<value_type>(value);
+    }
+
+    template <typename U>
+    constexpr void update(value_type& acc, const U& value) const {
+        acc += static_cast<value_type>(value);
+    }
+};
+
+template <typename T>
+struct min_reducer final {
+    using value_type = T;
+
+    constexpr value_type init(const T& value) const {
+        return value;
+    }
+
+    constexpr void update(value_type& acc, const T& value) const {
+        acc = std::min(acc, value);
+    }
+};
+
+template <typename T>
+struct max_reducer final {
+    using value_type = T;
+
+    constexpr value_type init(const T& value) const {
+        return value;
+    }
+
+    constexpr void update(value_type& acc, const T& value) const {
+        acc = std::max(acc, value);
+    }
+};
+
+template <
+    typename K,
+    typename T,
+    typename Reducer,
+    typename Hash     = key_hash<K>,
+    typename KeyEqual = std::equal_to<>>
+    requires aggregate_reducer<Reducer, T>
+struct basic_hash_aggregator final {
+    using key_type         = K;
+    using value_type       = T;
+    using accumulator_type = typename Reducer::value_type;
+    using table_type       = basic_hash_table<K, accumulator_type, Hash, KeyEqual>;
+
+private:
+    struct record final {
+        K key;
+        T value;
+    };
+
+    std::vector<std::unique_ptr<table_type>> partitions_;
+    unsigned radix_bits_ = 0;
+
+    work_stealing_pool* pool_ = nullptr;
+
+    [[no_unique_address]] Reducer reducer_ = {};
+    [[no_unique_address]] Hash hash_       = {};
+
+    std::vector<record> staging_;
+    std::vector<std::uint32_t> targets_;
+
+    size_t partition_of_(const K& key) const {
+        if (radix_bits_ == 0) {
+            return 0;
+        }
+        auto h = static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h >> (64 - radix_bits_));
+    }
+
+    template <typename F>
+    void run_tasks_(size_t tasks, F&& func) const {
+        if (!pool_ || tasks < 2) {
+            for (size_t i = 0; i < tasks; i++) {
+                func(i);
+            }
+            return;
+        }
+
+        task_group group;
+        for (size_t i = 0; i < tasks; i++) {
+            pool_->submit(group, [&func, i] { func(i); });
+        }
+        pool_->wait(group);
+    }
+
+    void reduce_(table_type& table, const K& key, const T& value) const {
+        if (auto* acc = table.find(key)) {
+            reducer_.update(*acc, value);
+        } else {
+            table.insert(key, reducer_.init(value));
+        }
+    }
+
+public:
+    explicit basic_hash_aggregator(
+        size_t partition_count,
+        work_stealing_pool* pool = nullptr,
+        Reducer reducer          = {}
+    )
+        : radix_bits_(std::bit_width(std::bit_ceil(std::max<size_t>(partition_count, 1))) - 1)
+        , pool_(pool)
+        , reducer_(std::move(reducer)) {
+        partitions_.reserve(size_t{1} << radix_bits_);
+        for (size_t i = 0; i < size_t{1} << radix_bits_; i++) {
+            partitions_.push_back(std::make_unique<table_type>());
+        }
+    }
+
+    static size_t partitions_for(
+        size_t expected_keys,
+        size_t threads,
+        size_t cache_bytes = size_t{1} << 20
+    ) {
+        auto node_budget   = cache_bytes > 2 * sizeof(table_type) ? cache_bytes - sizeof(table_type)
+                                                                  : cache_bytes / 2;
+        auto per_partition = std::max<size_t>(node_budget / sizeof(typename table_type::item), 1);
+        auto partitions    = (expected_keys + per_partition - 1) / per_partition;
+        return std::bit_ceil(std::max<size_t>({partitions, 4 * threads, 1}));
+    }
+
+    size_t partition_count() const {
+        return partitions_.size();
+    }
+
+    const table_type& partition(size_t index) const {
+        return *partitions_[index];
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& table : partitions_) {
+            total += table->size();
+        }
+        return total;
+    }
+
+    template <std::ranges::random_access_range R>
+    void add(const R& records) {
+        const auto count = static_cast<size_t>(std::ranges::size(records));
+        if (count == 0) {
+            return;
+        }
+
+        const auto parts = partitions_.size();
+        if (parts == 1) {
+            for (size_t i = 0; i < count; i++) {
+                const auto& [key, value] = records[i];
+                reduce_(*partitions_[0], key, value);
+            }
+            return;
+        }
+
+        auto chunks     = std::min(pool_ ? pool_->thread_count() : 1, count);
+        auto chunk_size = (count + chunks - 1) / chunks;
+        chunks          = (count + chunk_size - 1) / chunk_size;
+
+        targets_.resize(count);
+        std::vector<size_t> cursors(chunks * parts);
+        run_tasks_(chunks, [&](size_t chunk) {
+            auto* histogram = cursors.data() + chunk * parts;
+            auto end        = std::min(count, (chunk + 1) * chunk_size);
+            for (auto i = chunk * chunk_size; i < end; i++) {
+                const auto& [key, value] = records[i];
+                targets_[i]              = static_cast<std::uint32_t>(partition_of_(key));
+                histogram[targets_[i]]++;
+            }
+        });
+
+        std::vector<size_t> starts(parts + 1);
+        size_t offset = 0;
+        for (size_t p = 0; p < parts; p++) {
+            starts[p] = offset;
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                auto& cursor  = cursors[chunk * parts + p];
+                offset       += cursor;
+                cursor        = offset - cursor;
+            }
+        }
+        starts[parts] = offset;
+
+        staging_.resize(count);
+        run_tasks_(chunks, [&](size_t chunk) {
+            auto* cursor = cursors.data() + chunk * parts;
+            auto end     = std::min(count, (chunk + 1) * chunk_size);
+            for (auto i = chunk * chunk_size; i < end; i++) {
+                const auto& [key, value]        = records[i];
+                staging_[cursor[targets_[i]]++] = {key, value};
+            }
+        });
+
+        run_tasks_(parts, [&](size_t p) {
+            auto& table = *partitions_[p];
+            for (auto i = starts[p]; i < starts[p + 1]; i++) {
+                reduce_(table, staging_[i].key, staging_[i].value);
+            }
+        });
+    }
+
+    const accumulator_type* find(const K& key) const {
+        return partitions_[partition_of_(key)]->find(key);
+    }
+
+    template <typename F>
+    void for_each(F&& func) const {
+        for (const auto& table : partitions_) {
+            for (size_t b = 0; b < table_type::bucket_count; b++) {
+                for (const auto& it : table->bucket(b)) {
+                    func(it.key, it.value);
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<K, accumulator_type>> to_vector() const {
+        std::vector<std::pair<K, accumulator_type>> result;
+        result.reserve(size());
+        for_each([&result](const K& key, const accumulator_type& acc) {
+            result.emplace_back(key, acc);
+        });
+        return result;
+    }
+
+    void clear() {
+        for (auto& table : partitions_) {
+            table->clear();
+        }
+        staging_.clear();
+        staging_.shrink_to_fit();
+        targets_.clear();
+        targets_.shrink_to_fit();
+    }
+};
+
+template <typename T, typename Reducer>
+using hash_aggregator = basic_hash_aggregator<packed_key, T, Reducer>;
+
+#endif  // GUAP_ALGO_HASH_AGGREGATOR_H
@@ -5,11 +5,12 @@
 
 #include <array>
 #include <optional>
+#include <stdexcept>
 #include <string>
 
 inline constexpr size_t key_size = 6;
 
-inline size_t bad_hash_key(std::array<char, key_size> key) {
+constexpr size_t bad_hash_key(std::array<char, key_size> key) {
     size_t h = 1;
     h *= key[0] - 'A';
     h *= key[1] - '0';
@@ -21,7 +22,7 @@ inline size_t bad_hash_key(std::array<char, key_size> key) {
     return h;
 }
 
-inline size_t hash_key(std::array<char, key_size> key) {
+constexpr size_t text_hash_key(std::array<char, key_size> key) {
     constexpr size_t p = 131ull;
     constexpr size_t m = 1000000007ull;
 
@@ -37,15 +38,15 @@ inline size_t hash_key(std::array<char, key_size> key) {
     return h;
 }
 
-inline bool is_letter(char c) {
+constexpr bool is_letter(char c) {
     return c >= 'A' && c <= 'Z';
 }
 
-inline bool is_number(char c) {
+constexpr bool is_number(char c) {
     return c >= '0' && c <= '9';
 }
 
-inline bool is_valid_key(std::array<char, key_size> key) {
+constexpr bool is_valid_key(std::array<char, key_size> key) {
     return (
         is_letter(key[0]) &&  //
         is_number(key[1]) &&  //
@@ -56,6 +57,17 @@ inline bool is_valid_key(std::array<char, key_size> key) {
     );
 }
 
+consteval std::array<char, key_size> to_key(const char (&text)[key_size + 1]) {
+    std::array<char, key_size> key = {};
+    for (size_t i = 0; i < key_size; i++) {
+        key[i] = text[i];
+    }
+    if (!is_valid_key(key)) {
+        throw std::invalid_argument("invalid key format");
+    }
+    return key;
+}
+
 struct key_gen {
 private:
     static inline const std::string format_ = "A000AA";
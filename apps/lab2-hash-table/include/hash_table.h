@@ -3,87 +3,735 @@
 #ifndef GUAP_ALGO_HASH_MAP_H
 #define GUAP_ALGO_HASH_MAP_H
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "hash_bucket.h"
 #include "hash_key.h"
+#include "hash_table_stats.h"
+#include "key_hash.h"
+#include "key_index.h"
+#include "membership_filter.h"
+#include "packed_key.h"
+#include "work_stealing_pool.h"
 
-template <typename V>
-struct hash_table {
+enum class duplicate_policy {
+    first_wins,
+    last_wins,
+};
+
+template <
+    typename K,
+    typename V,
+    typename Hash      = key_hash<K>,
+    typename KeyEqual  = std::equal_to<>,
+    typename Allocator = std::allocator<V>>
+struct basic_hash_table {
     static constexpr size_t bucket_count = 1500;
+    static constexpr bool caches_hash    = caches_hash_v<K>;
 
-    using key_type = std::array<char, key_size>;
+    using key_type    = K;
+    using mapped_type = V;
+    using hasher      = Hash;
+    using key_equal   = KeyEqual;
 
     struct item {
         key_type key;
         V value;
+        list_hook<item> hook;
+        [[no_unique_address]] cached_hash<caches_hash> hash;
     };
 
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<item>;
+    using bucket_type    = hash_bucket<item, &item::hook, allocator_type>;
+    using node_handle    = typename bucket_type::node_handle;
+
 private:
-    hash_bucket<item> buckets_[bucket_count] = {};
+    template <typename Q>
+    static constexpr bool text_lookup_ =
+        std::same_as<K, packed_key> && (std::convertible_to<const Q&, std::string_view> ||
+                                        std::same_as<Q, std::span<const char, key_size>>);
+
+    template <typename Q>
+    static constexpr bool transparent_lookup_ =
+        !std::same_as<K, packed_key> &&
+        requires(const Hash& hash, const KeyEqual& equal, const K& lhs, const Q& rhs) {
+            typename Hash::is_transparent;
+            hash(rhs);
+            equal(lhs, rhs);
+        };
 
-    size_t bucket_by_key_(key_type key) const {
-        return hash_key(key) % bucket_count;
+    template <typename Q>
+    static constexpr auto parse_(const Q& key) {
+        if constexpr (std::convertible_to<const Q&, std::string_view>) {
+            return parse_key(std::string_view(key));
+        } else {
+            return parse_key(key);
+        }
     }
 
-public:
-    V& operator[](key_type key) {
-        auto& bucket = buckets_[bucket_by_key_(key)];
-        for (auto& it : bucket) {
-            if (it.key == key) {
-                return it.value;
+    template <typename Q>
+    static constexpr bool lookup_key_ =
+        !std::same_as<Q, K> && (text_lookup_<Q> || transparent_lookup_<Q>);
+
+    bucket_type buckets_[bucket_count] = {};
+    size_t size_                       = 0;
+    bool ordered_chains_               = false;
+
+    [[no_unique_address]] Hash hash_      = {};
+    [[no_unique_address]] KeyEqual equal_ = {};
+
+    counting_bloom_filter filter_;
+    key_index<const item*> index_;
+
+    [[no_unique_address]] mutable hash_table_counters counters_ = {};
+
+    struct bulk_block final {
+        item* data  = nullptr;
+        size_t size = 0;
+
+        [[no_unique_address]] allocator_type alloc = {};
+
+        constexpr bulk_block() = default;
+
+        constexpr bulk_block(const bulk_block&) {}
+        bulk_block& operator=(const bulk_block&) = delete;
+
+        constexpr bulk_block(bulk_block&& rhs) noexcept
+            : data(std::exchange(rhs.data, nullptr))
+            , size(std::exchange(rhs.size, 0)) {}
+        bulk_block& operator=(bulk_block&&) = delete;
+    };
+
+    bulk_block bulk_ = {};
+
+    using node_traits_ = std::allocator_traits<allocator_type>;
+
+    constexpr bool in_bulk_(const item* node) const {
+        return bulk_.size != 0 && std::less_equal<>{}(bulk_.data, node) &&
+               std::less<>{}(node, bulk_.data + bulk_.size);
+    }
+
+    constexpr void erase_(bucket_type& bucket, typename bucket_type::iterator it, size_t hash) {
+        if (in_bulk_(it.current)) {
+            count_remove_(it->key, hash);
+            node_traits_::destroy(bulk_.alloc, bucket.unlink(it));
+        } else {
+            count_remove_(it->key, hash);
+            bucket.erase(it);
+        }
+    }
+
+    constexpr void release_bulk_() {
+        if (bulk_.size == 0) {
+            return;
+        }
+
+        for (auto& bucket : buckets_) {
+            for (auto it = bucket.begin(); it != bucket.end();) {
+                auto current = it++;
+                if (in_bulk_(current.current)) {
+                    node_traits_::destroy(bulk_.alloc, bucket.unlink(current));
+                }
+            }
+        }
+        node_traits_::deallocate(bulk_.alloc, bulk_.data, bulk_.size);
+        bulk_.data = nullptr;
+        bulk_.size = 0;
+    }
+
+    template <typename F>
+    static void run_chunks_(work_stealing_pool* pool, size_t chunks, F&& func) {
+        if (!pool || chunks < 2) {
+            for (size_t i = 0; i < chunks; i++) {
+                func(i);
+            }
+            return;
+        }
+
+        task_group group;
+        for (size_t i = 0; i < chunks; i++) {
+            pool->submit(group, [&func, i] { func(i); });
+        }
+        pool->wait(group);
+    }
+
+    template <typename Bucket, typename Q>
+    constexpr auto find_(Bucket& bucket, const Q& key, size_t hash, bool lookup = false) const {
+        if (filter_.is_enabled() && !filter_.may_contain(hash)) {
+            if !consteval {
+                if (lookup) {
+                    counters_.record_lookup(0, false);
+                    counters_.record_filter_reject();
+                }
+            }
+            return bucket.end();
+        }
+
+        size_t probes = 0;
+        auto it       = bucket.begin();
+        for (; it != bucket.end(); ++it) {
+            probes++;
+            if (it->hash.matches(hash) && equal_(it->key, key)) {
+                break;
+            }
+            if constexpr (std::totally_ordered_with<K, Q>) {
+                if (ordered_chains_ && key < it->key) {
+                    it = bucket.end();
+                    break;
+                }
+            }
+        }
+        if !consteval {
+            if (lookup) {
+                counters_.record_lookup(probes, it != bucket.end());
+                if (filter_.is_enabled() && it == bucket.end()) {
+                    counters_.record_filter_false_positive();
+                }
+            }
+        }
+        return it;
+    }
+
+    constexpr auto chain_position_(bucket_type& bucket, const K& key) const {
+        auto it = bucket.end();
+        if constexpr (std::totally_ordered<K>) {
+            if (ordered_chains_) {
+                it = bucket.begin();
+                while (it != bucket.end() && !(key < it->key)) {
+                    ++it;
+                }
             }
         }
-        bucket.push_back({key, V{}});
-        return bucket.back().value;
+        return it;
     }
 
-    const V& operator[](key_type key) const {
-        for (const auto& it : buckets_[bucket_by_key_(key)]) {
-            if (it.key == key) {
-                return it.value;
+    constexpr void check_index_key_(const K& key) const {
+        if constexpr (std::same_as<K, packed_key>) {
+            if (index_.is_enabled() && !index_.in_range(key)) {
+                throw std::out_of_range("key outside the packed key space");
             }
         }
+    }
+
+    constexpr item& emplace_(bucket_type& bucket, const K& key, V value, size_t hash) {
+        check_index_key_(key);
+        auto& node = *bucket.emplace(chain_position_(bucket, key), key, std::move(value));
+        node.hash.store(hash);
+
+        size_++;
+        if (filter_.is_enabled()) {
+            filter_.insert(hash);
+        }
+        index_insert_(node);
+        if !consteval {
+            counters_.record_insert(bucket.size() > 1);
+        }
+        return node;
+    }
+
+    constexpr void index_insert_(const item& node) {
+        if constexpr (std::same_as<K, packed_key>) {
+            if (index_.is_enabled()) {
+                index_.insert(node.key, &node);
+            }
+        }
+    }
+
+    constexpr void count_remove_(const K& key, size_t hash) {
+        size_--;
+        if (filter_.is_enabled()) {
+            filter_.remove(hash);
+        }
+        if constexpr (std::same_as<K, packed_key>) {
+            if (index_.is_enabled()) {
+                index_.erase(key);
+            }
+        }
+        if !consteval {
+            counters_.record_remove();
+        }
+    }
+
+public:
+    constexpr basic_hash_table() = default;
+
+    constexpr basic_hash_table(const basic_hash_table& rhs)
+        : size_(rhs.size_)
+        , ordered_chains_(rhs.ordered_chains_)
+        , hash_(rhs.hash_)
+        , equal_(rhs.equal_)
+        , filter_(rhs.filter_)
+        , counters_(rhs.counters_) {
+        std::ranges::copy(rhs.buckets_, buckets_);
+        if constexpr (std::same_as<K, packed_key>) {
+            if (rhs.index_.is_enabled()) {
+                enable_index();
+            }
+        }
+    }
+
+    constexpr basic_hash_table(basic_hash_table&&) noexcept = default;
+
+    constexpr basic_hash_table& operator=(const basic_hash_table& rhs) {
+        if (this != &rhs) {
+            *this = basic_hash_table(rhs);
+        }
+        return *this;
+    }
+
+    constexpr basic_hash_table& operator=(basic_hash_table&& rhs) noexcept {
+        if (this == &rhs) {
+            return *this;
+        }
+
+        clear();
+        std::swap(buckets_, rhs.buckets_);
+        std::swap(size_, rhs.size_);
+        std::swap(ordered_chains_, rhs.ordered_chains_);
+        std::swap(hash_, rhs.hash_);
+        std::swap(equal_, rhs.equal_);
+        std::swap(filter_, rhs.filter_);
+        std::swap(index_, rhs.index_);
+        std::swap(bulk_.data, rhs.bulk_.data);
+        std::swap(bulk_.size, rhs.bulk_.size);
+        return *this;
+    }
+
+    constexpr ~basic_hash_table() {
+        release_bulk_();
+    }
+
+    constexpr size_t bucket_of(const K& key) const {
+        return hash_(key) % bucket_count;
+    }
+
+    constexpr size_t size() const {
+        return size_;
+    }
+
+    constexpr V& operator[](const K& key) {
+        auto hash    = hash_(key);
+        auto& bucket = buckets_[hash % bucket_count];
+        if (auto it = find_(bucket, key, hash); it != bucket.end()) {
+            return it->value;
+        }
+        return emplace_(bucket, key, V{}, hash).value;
+    }
+
+    constexpr const V& operator[](const K& key) const {
+        if (const auto* value = find(key)) {
+            return *value;
+        }
         throw std::out_of_range("key not found");
     }
 
-    void insert(key_type key, V value) {
-        auto& bucket = buckets_[bucket_by_key_(key)];
-        for (auto& it : bucket) {
-            if (it.key == key) {
-                it.value = value;
-                return;
+    constexpr void insert(const K& key, V value) {
+        auto hash    = hash_(key);
+        auto& bucket = buckets_[hash % bucket_count];
+        if (auto it = find_(bucket, key, hash); it != bucket.end()) {
+            it->value = std::move(value);
+            return;
+        }
+        emplace_(bucket, key, std::move(value), hash);
+    }
+
+    constexpr bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    template <typename Q>
+        requires lookup_key_<Q>
+    constexpr bool contains(const Q& key) const {
+        return find(key) != nullptr;
+    }
+
+    constexpr V* find(const K& key) {
+        auto hash    = hash_(key);
+        auto& bucket = buckets_[hash % bucket_count];
+        if (auto it = find_(bucket, key, hash, true); it != bucket.end()) {
+            return &it->value;
+        }
+        return nullptr;
+    }
+
+    constexpr const V* find(const K& key) const {
+        auto hash          = hash_(key);
+        const auto& bucket = buckets_[hash % bucket_count];
+        if (auto it = find_(bucket, key, hash, true); it != bucket.end()) {
+            return &it->value;
+        }
+        return nullptr;
+    }
+
+    template <typename Q>
+        requires lookup_key_<Q>
+    constexpr V* find(const Q& key) {
+        return const_cast<V*>(std::as_const(*this).find(key));
+    }
+
+    template <typename Q>
+        requires lookup_key_<Q>
+    constexpr const V* find(const Q& key) const {
+        if constexpr (text_lookup_<Q>) {
+            auto packed = parse_(key);
+            return packed.has_value() ? find(packed.value()) : nullptr;
+        } else {
+            auto hash          = hash_(key);
+            const auto& bucket = buckets_[hash % bucket_count];
+            if (auto it = find_(bucket, key, hash, true); it != bucket.end()) {
+                return &it->value;
+            }
+            return nullptr;
+        }
+    }
+
+    constexpr void remove(const K& key) {
+        auto hash    = hash_(key);
+        auto& bucket = buckets_[hash % bucket_count];
+        if (auto it = find_(bucket, key, hash); it != bucket.end()) {
+            erase_(bucket, it, hash);
+        }
+    }
+
+    template <typename Q>
+        requires lookup_key_<Q>
+    constexpr void remove(const Q& key) {
+        if constexpr (text_lookup_<Q>) {
+            if (auto packed = parse_(key)) {
+                remove(packed.value());
+            }
+        } else {
+            auto hash    = hash_(key);
+            auto& bucket = buckets_[hash % bucket_count];
+            if (auto it = find_(bucket, key, hash); it != bucket.end()) {
+                erase_(bucket, it, hash);
+            }
+        }
+    }
+
+    constexpr node_handle extract(const K& key) {
+        auto hash    = hash_(key);
+        auto& bucket = buckets_[hash % bucket_count];
+        auto it      = find_(bucket, key, hash);
+        if (it == bucket.end()) {
+            return {};
+        }
+
+        count_remove_(key, hash);
+        if (!in_bulk_(it.current)) {
+            return bucket.extract(it);
+        }
+
+        auto* node = bucket.unlink(it);
+        bucket_type scratch;
+        scratch.emplace_back(std::move(node->key), std::move(node->value));
+        node_traits_::destroy(bulk_.alloc, node);
+        return scratch.extract(scratch.begin());
+    }
+
+    constexpr bool insert(node_handle&& handle) {
+        if (handle.is_empty()) {
+            return false;
+        }
+
+        auto hash    = hash_(handle.value().key);
+        auto& bucket = buckets_[hash % bucket_count];
+        if (find_(bucket, handle.value().key, hash) != bucket.end()) {
+            return false;
+        }
+        check_index_key_(handle.value().key);
+        auto position = chain_position_(bucket, handle.value().key);
+        auto* node    = bucket.insert(position, std::move(handle)).current;
+        node->hash.store(hash);
+        index_insert_(*node);
+
+        size_++;
+        if (filter_.is_enabled()) {
+            filter_.insert(hash);
+        }
+        if !consteval {
+            counters_.record_insert(bucket.size() > 1);
+        }
+        return true;
+    }
+
+    template <std::ranges::random_access_range R>
+    void bulk_load(
+        const R& entries,
+        duplicate_policy policy  = duplicate_policy::last_wins,
+        work_stealing_pool* pool = nullptr
+    ) {
+        for (const auto& [key, value] : entries) {
+            check_index_key_(key);
+        }
+        clear();
+
+        const auto count = static_cast<size_t>(std::ranges::size(entries));
+        if (count == 0) {
+            return;
+        }
+
+        auto chunks     = std::min(pool ? pool->thread_count() : 1, count);
+        auto chunk_size = (count + chunks - 1) / chunks;
+        chunks          = (count + chunk_size - 1) / chunk_size;
+
+        std::vector<size_t> hashes(count);
+        std::vector<std::array<size_t, bucket_count>> cursors(chunks);
+        run_chunks_(pool, chunks, [&](size_t chunk) {
+            auto& histogram = cursors[chunk];
+            auto end        = std::min(count, (chunk + 1) * chunk_size);
+            for (auto i = chunk * chunk_size; i < end; i++) {
+                const auto& [key, value] = entries[i];
+                hashes[i]                = hash_(key);
+                histogram[hashes[i] % bucket_count]++;
+            }
+        });
+
+        std::vector<size_t> starts(bucket_count + 1);
+        size_t offset = 0;
+        for (size_t b = 0; b < bucket_count; b++) {
+            starts[b] = offset;
+            for (auto& histogram : cursors) {
+                offset       += histogram[b];
+                histogram[b]  = offset - histogram[b];
+            }
+        }
+        starts[bucket_count] = offset;
+
+        std::vector<size_t> order(count);
+        run_chunks_(pool, chunks, [&](size_t chunk) {
+            auto& cursor = cursors[chunk];
+            auto end     = std::min(count, (chunk + 1) * chunk_size);
+            for (auto i = chunk * chunk_size; i < end; i++) {
+                order[cursor[hashes[i] % bucket_count]++] = i;
+            }
+        });
+
+        auto key_at = [&entries](size_t i) -> const K& {
+            const auto& [key, value] = entries[i];
+            return key;
+        };
+
+        const auto bucket_chunk = (bucket_count + chunks - 1) / chunks;
+        std::vector<size_t> kept(bucket_count);
+        run_chunks_(pool, chunks, [&](size_t chunk) {
+            auto end = std::min(bucket_count, (chunk + 1) * bucket_chunk);
+            for (auto b = chunk * bucket_chunk; b < end; b++) {
+                auto first = order.begin() + starts[b];
+                auto last  = order.begin() + starts[b + 1];
+                std::stable_sort(first, last, [&hashes](size_t lhs, size_t rhs) {
+                    return hashes[lhs] < hashes[rhs];
+                });
+
+                auto out = first;
+                for (auto run = first; run != last;) {
+                    auto run_end = std::find_if(run, last, [&](size_t i) {
+                        return hashes[i] != hashes[*run];
+                    });
+                    auto run_out = out;
+                    for (auto it = run; it != run_end; ++it) {
+                        auto same = std::find_if(run_out, out, [&](size_t i) {
+                            return equal_(key_at(i), key_at(*it));
+                        });
+                        if (same == out) {
+                            *out++ = *it;
+                        } else if (policy == duplicate_policy::last_wins) {
+                            *same = *it;
+                        }
+                    }
+                    run = run_end;
+                }
+                kept[b] = out - first;
+            }
+        });
+
+        size_t total = 0;
+        std::vector<size_t> slots(bucket_count);
+        for (size_t b = 0; b < bucket_count; b++) {
+            slots[b]  = total;
+            total    += kept[b];
+        }
+
+        bulk_.data = node_traits_::allocate(bulk_.alloc, total);
+        bulk_.size = total;
+        size_      = total;
+
+        run_chunks_(pool, chunks, [&](size_t chunk) {
+            auto end = std::min(bucket_count, (chunk + 1) * bucket_chunk);
+            for (auto b = chunk * bucket_chunk; b < end; b++) {
+                for (size_t k = 0; k < kept[b]; k++) {
+                    auto index               = order[starts[b] + k];
+                    const auto& [key, value] = entries[index];
+
+                    auto* node = bulk_.data + slots[b] + k;
+                    node_traits_::construct(bulk_.alloc, node, key, value);
+                    node->hash.store(hashes[index]);
+                    buckets_[b].link_back(*node);
+                    counters_.record_insert(k > 0);
+                }
+                if constexpr (std::totally_ordered<K>) {
+                    if (ordered_chains_) {
+                        buckets_[b].sort({}, &item::key);
+                    }
+                }
+            }
+        });
+
+        if (filter_.is_enabled()) {
+            for (size_t b = 0; b < bucket_count; b++) {
+                for (size_t k = 0; k < kept[b]; k++) {
+                    filter_.insert(hashes[order[starts[b] + k]]);
+                }
             }
         }
-        bucket.push_back({key, value});
+        if constexpr (std::same_as<K, packed_key>) {
+            if (index_.is_enabled()) {
+                for (size_t i = 0; i < total; i++) {
+                    index_.insert(bulk_.data[i].key, bulk_.data + i);
+                }
+            }
+        }
+    }
+
+    constexpr void clear() {
+        release_bulk_();
+        for (auto& bucket : buckets_) {
+            bucket.clear();
+        }
+        size_ = 0;
+        filter_.clear();
+        index_.clear();
+    }
+
+    constexpr bool ordered_chains() const {
+        return ordered_chains_;
     }
 
-    bool contains(key_type key) const {
-        for (const auto& it : buckets_[bucket_by_key_(key)]) {
-            if (it.key == key) {
-                return true;
+    constexpr void set_ordered_chains(bool enabled)
+        requires std::totally_ordered<K>
+    {
+        if (enabled && !ordered_chains_) {
+            for (auto& bucket : buckets_) {
+                bucket.sort({}, &item::key);
             }
         }
-        return false;
+        ordered_chains_ = enabled;
     }
 
-    void remove(key_type key) {
-        hash_bucket<item>& bucket = buckets_[bucket_by_key_(key)];
-        for (auto it = bucket.begin(); it != bucket.end(); ++it) {
-            if (it->key == key) {
-                bucket.erase(it);
-                return;
+    void enable_filter(filter_config config = {}) {
+        filter_.configure(config);
+        for (const auto& bucket : buckets_) {
+            for (const auto& it : bucket) {
+                filter_.insert(hash_(it.key));
             }
         }
     }
 
-    hash_bucket<item>& bucket(size_t index) {
+    constexpr void disable_filter() {
+        filter_.reset();
+    }
+
+    void enable_index()
+        requires std::same_as<K, packed_key>
+    {
+        for (const auto& bucket : buckets_) {
+            for (const auto& it : bucket) {
+                if (!index_.in_range(it.key)) {
+                    throw std::out_of_range("key outside the packed key space");
+                }
+            }
+        }
+
+        index_.enable();
+        for (const auto& bucket : buckets_) {
+            for (const auto& it : bucket) {
+                index_.insert(it.key, &it);
+            }
+        }
+    }
+
+    void disable_index() {
+        index_.reset();
+    }
+
+    bool has_index() const {
+        return index_.is_enabled();
+    }
+
+    template <typename F>
+        requires std::same_as<K, packed_key>
+    void scan_range(key_range range, F&& func) const {
+        if (index_.is_enabled()) {
+            index_.scan(range, [&](packed_key key, const item* it) { func(key, it->value); });
+            return;
+        }
+
+        std::vector<const item*> matches;
+        for (const auto& bucket : buckets_) {
+            for (const auto& it : bucket) {
+                if (range.first <= it.key && it.key <= range.last) {
+                    matches.push_back(&it);
+                }
+            }
+        }
+        std::ranges::sort(matches, {}, &item::key);
+        for (const auto* it : matches) {
+            func(it->key, it->value);
+        }
+    }
+
+    template <typename F>
+        requires std::same_as<K, packed_key>
+    bool scan_prefix(std::string_view prefix, F&& func) const {
+        auto range = prefix_range(prefix);
+        if (!range.has_value()) {
+            return false;
+        }
+        scan_range(range.value(), std::forward<F>(func));
+        return true;
+    }
+
+    template <typename F>
+        requires std::same_as<K, packed_key>
+    void for_each_ordered(F&& func) const {
+        scan_range({packed_key{0}, packed_key{packed_key_count - 1}}, std::forward<F>(func));
+    }
+
+    hash_table_stats stats() const {
+        hash_table_stats result;
+        counters_.fill(result);
+        result.filter      = filter_.stats();
+        result.index_bytes = index_.memory_bytes();
+
+        result.items = size_;
+        result.occupancy.resize(bucket_count);
+        for (size_t i = 0; i < bucket_count; i++) {
+            result.occupancy[i]  = buckets_[i].size();
+            result.longest_chain = std::max(result.longest_chain, buckets_[i].size());
+        }
+        return result;
+    }
+
+    constexpr bucket_type& bucket(size_t index) {
         return buckets_[index];
     }
 
-    const hash_bucket<item>& bucket(size_t index) const {
+    constexpr const bucket_type& bucket(size_t index) const {
         return buckets_[index];
     }
 };
 
+template <typename V>
+using hash_table = basic_hash_table<packed_key, V>;
+
 #endif  // GUAP_ALGO_HASH_MAP_H
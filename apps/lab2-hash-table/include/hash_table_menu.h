@@ -4,62 +4,61 @@
 #define GUAP_ALGO_MENU_H
 
 #include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <functional>
-#include <iostream>
+#include <memory>
 #include <numeric>
-#include <print>
 
+#include "console.h"
 #include "hash_key.h"
+#include "cow_hash_table.h"
 #include "hash_table.h"
+#include "table_dump.h"
 
 struct hash_table_menu {
 private:
-    hash_table<int> table_ = {};
-    bool is_running_       = true;
+    console io_;
+    cow_hash_table<packed_key, int> table_;
+    std::unique_ptr<table_dump_engine> dump_engine_;
+    bool is_running_ = true;
 
     std::unordered_map<std::string, std::function<void()>> actions_ = {
         {"a", [this] { add_element_(); }},
         {"f", [this] { find_element_(); }},
         {"d", [this] { remove_element_(); }},
         {"p", [this] { print_table_(); }},
-        {"pp", [this] { dump_table_(); }},
+        {"pp", [this] { dump_table_(dump_compression::none); }},
+        {"pz", [this] { dump_table_(dump_compression::gzip); }},
         {"i", [this] { print_hash_analysis_(); }},
+        {"s", [this] { print_stats_(); }},
         {"h", [this] { print_menu_(); }},
         {"q", [this] { is_running_ = false; }},
     };
 
     void print_menu_() {
-        std::println("a. Добавить элемент");
-        std::println("f. Найти элемент");
-        std::println("d. Удалить элемент");
-        std::println("p. Вывести содержимое на экран");
-        std::println("i. Проанализировать качество хэш функции");
-        std::println("q. Выход");
-        std::println("h. Показать меню");
-        std::println();
-        std::println("Формат ключа для хэш таблицы - 'A000AA'");
-        std::println("Количества бакетов в таблице - {}", hash_table<int>::bucket_count);
-    }
-
-    template <typename T>
-    std::optional<T> strict_scan() {
-        T value;
-        std::cin >> value;
-        if (std::cin.fail()) {
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Ошибка ввода. Попробуйте снова.\n";
-            return {};
+        if (!io_.is_interactive()) {
+            return;
         }
-        return {value};
+
+        io_.out.println("a. Добавить элемент");
+        io_.out.println("f. Найти элемент");
+        io_.out.println("d. Удалить элемент");
+        io_.out.println("p. Вывести содержимое на экран");
+        io_.out.println("i. Проанализировать качество хэш функции");
+        io_.out.println("s. Показать статистику работы таблицы");
+        io_.out.println("q. Выход");
+        io_.out.println("h. Показать меню");
+        io_.out.println();
+        io_.out.println("Формат ключа для хэш таблицы - 'A000AA'");
+        io_.out.println("Количества бакетов в таблице - {}", hash_table<int>::bucket_count);
     }
 
     std::string request_choice_() {
         std::optional<std::string> choice;
         while (!choice.has_value()) {
-            std::print(": ");
-            choice = strict_scan<std::string>();
+            io_.prompt(": ");
+            choice = io_.scan<std::string>();
             if (!choice.has_value()) {
                 print_menu_();
             }
@@ -67,56 +66,45 @@ private:
         return choice.value();
     }
 
-    std::array<char, key_size> request_key_() {
-        std::println("Введите ключ (формат 'A000AA')");
-        std::optional<std::string> input_key;
-        std::array<char, key_size> key = {};
+    packed_key request_key_() {
+        io_.prompt("Введите ключ (формат 'A000AA')\n");
+        std::optional<packed_key> key;
 
-        while (!input_key.has_value()) {
-            std::print("> ");
-            input_key = strict_scan<std::string>();
-
-            if (input_key.has_value()) {
-                if (auto key_str = input_key.value(); key_str.size() != key_size) {
-                    input_key.reset();
-                } else {
-                    std::ranges::copy_n(key_str.begin(), key_size, key.begin());
-                    if (!is_valid_key(key)) {
-                        input_key.reset();
-                    }
-                }
-
-                if (!input_key.has_value()) {
-                    std::println("Некорректный формат ключа. Попробуйте снова.");
+        while (!key.has_value()) {
+            io_.prompt("> ");
+            if (auto input_key = io_.scan<std::string>(); input_key.has_value()) {
+                key = parse_key(input_key.value());
+                if (!key.has_value()) {
+                    io_.out.println("Некорректный формат ключа. Попробуйте снова.");
                 }
             }
         }
 
-        return key;
+        return key.value();
     }
 
     int request_value_() {
-        std::println("Введите значение (целое число)");
+        io_.prompt("Введите значение (целое число)\n");
         std::optional<int> input_value;
 
         while (!input_value.has_value()) {
-            std::print("> ");
-            input_value = strict_scan<int>();
+            io_.prompt("> ");
+            input_value = io_.scan<int>();
         }
 
         return input_value.value();
     }
 
     void add_element_() {
-        auto key    = request_key_();
-        table_[key] = request_value_();
+        auto key = request_key_();
+        table_.insert(key, request_value_());
     }
 
     void find_element_() {
-        if (auto key = request_key_(); table_.contains(key)) {
-            std::println("Значение {}", table_[key]);
+        if (auto value = table_.find(request_key_())) {
+            io_.out.println("Значение {}", *value);
         } else {
-            std::println("Элемент с таким ключом не найден.");
+            io_.out.println("Элемент с таким ключом не найден.");
         }
     }
 
@@ -125,26 +113,26 @@ private:
     }
 
     void print_table_() {
+        auto view = table_.snapshot();
         for (size_t i = 0; i < hash_table<int>::bucket_count; i++) {
-            if (const auto& bucket = table_.bucket(i); !bucket.is_empty()) {
-                std::println("{}", i);
+            if (const auto& bucket = view.bucket(i); !bucket.is_empty()) {
+                io_.out.println("{}", i);
                 size_t j = 0;
-                for (const auto& [key, value] : bucket) {
+                for (const auto& it : bucket) {
                     if (j++ < bucket.size() - 1) {
-                        std::print("├");
+                        io_.out.print("├");
                     } else {
-                        std::print("└");
+                        io_.out.print("└");
                     }
-                    std::string key_str(key.begin(), key.end());
-                    std::println(" {} = {}", key_str, value);
+                    io_.out.println(" {} = {}", it.key.str(), it.value);
                 }
-                std::println();
+                io_.out.println();
             }
         }
     }
 
     void print_hash_analysis_() {
-        std::println("Анализ качества хэш функции перебором всех возможных ключей");
+        io_.out.println("Анализ качества хэш функции перебором всех возможных ключей");
 
         constexpr auto bucket_count = hash_table<int>::bucket_count;
 
@@ -155,10 +143,10 @@ private:
         while (auto result = gen.next()) {
             auto key = result.value();
             key_count++;
-            buckets[hash_key(key) % bucket_count]++;
+            buckets[table_.bucket_of(key)]++;
         }
 
-        std::println("Всего ключей было сгенерировано\t\t{}", key_count);
+        io_.out.println("Всего ключей было сгенерировано\t\t{}", key_count);
 
         auto bucket_ideal = key_count / bucket_count;
 
@@ -166,44 +154,79 @@ private:
         auto bucket_min = *std::ranges::min_element(buckets);
         auto bucket_max = *std::ranges::max_element(buckets);
 
-        std::println("Средняя наполненность бакета\t\t{}", bucket_avg);
-        std::println("Минимальная наполненность бакета\t{}", bucket_min);
-        std::println("Максимальная наполненность бакета\t{}", bucket_max);
-        std::println("Идеальная наполненность бакета\t\t{}", bucket_ideal);
+        io_.out.println("Средняя наполненность бакета\t\t{}", bucket_avg);
+        io_.out.println("Минимальная наполненность бакета\t{}", bucket_min);
+        io_.out.println("Максимальная наполненность бакета\t{}", bucket_max);
+        io_.out.println("Идеальная наполненность бакета\t\t{}", bucket_ideal);
 
         auto quality = static_cast<float>(bucket_min) / bucket_ideal;
-        std::println("Качество хэш функции [0..1)\t\t{}", quality);
+        io_.out.println("Качество хэш функции [0..1)\t\t{}", quality);
     }
 
-    void dump_table_() {
-        std::ofstream file("dump.csv", std::ios::out);
-        if (!file.is_open()) {
-            std::println("Не удалось создать файл для дампа.");
+    void print_stats_() {
+        if (!hash_table_stats_enabled) {
+            io_.out.println("Статистика отключена при сборке (GUAP_ALGO_HASH_TABLE_STATS).");
             return;
         }
 
-        for (size_t i = 0; i < hash_table<int>::bucket_count; i++) {
-            if (const auto& bucket = table_.bucket(i); !bucket.is_empty()) {
-                for (const auto& [key, value] : bucket) {
-                    std::string key_str(key.begin(), key.end());
-                    file << i << "," << key_str << "," << value << "\n";
-                }
-            }
+        auto stats = table_.stats();
+        io_.out.println("Элементов в таблице\t\t\t{}", stats.items);
+        io_.out.println("Попаданий / промахов\t\t\t{} / {}", stats.hits, stats.misses);
+        io_.out.println("Доля попаданий\t\t\t\t{:.3f}", stats.hit_rate());
+        io_.out.println("Среднее число проб на поиск\t\t{:.3f}", stats.avg_probes());
+        io_.out.println(
+            "Вставок / с коллизией\t\t\t{} / {}",
+            stats.inserts,
+            stats.insert_collisions
+        );
+        io_.out.println("Удалений\t\t\t\t{}", stats.removes);
+        io_.out.println("Самая длинная цепочка\t\t\t{}", stats.longest_chain);
+
+        std::ofstream csv("stats.csv", std::ios::out);
+        std::ofstream json("stats.json", std::ios::out);
+        if (!csv.is_open() || !json.is_open()) {
+            io_.out.println("Не удалось создать файлы статистики.");
+            return;
+        }
+        write_stats_csv(csv, stats);
+        write_stats_json(json, stats);
+        io_.out.println("Статистика сохранена в файлы stats.csv и stats.json");
+    }
+
+    void dump_table_(dump_compression compression) {
+        if (compression == dump_compression::gzip && !dump_gzip_supported) {
+            io_.out.println("Сжатие недоступно: программа собрана без zlib.");
+            return;
+        }
+        auto path = compression == dump_compression::gzip ? "dump.csv.gz" : "dump.csv";
+
+        if (!dump_engine_) {
+            dump_engine_ = std::make_unique<table_dump_engine>();
+        }
+        if (!dump_engine_->dump_csv(table_.snapshot(), path, compression)) {
+            io_.out.println("Не удалось создать файл для дампа.");
+            return;
         }
 
-        std::println("Дамп хэш таблицы сохранён в файл dump.csv");
+        io_.out.println("Дамп хэш таблицы сохранён в файл {}", path);
     }
 
 public:
+    explicit hash_table_menu(std::FILE* input = stdin, bool interactive = true)
+        : io_(input, interactive) {}
+
     int run() {
-        print_menu_();
-        while (is_running_) {
-            if (auto choice = request_choice_(); actions_.contains(choice)) {
-                actions_[choice]();
-            } else {
-                std::println("Некорректный выбор. Попробуйте снова.");
-                print_menu_();
+        try {
+            print_menu_();
+            while (is_running_) {
+                if (auto choice = request_choice_(); actions_.contains(choice)) {
+                    actions_[choice]();
+                } else {
+                    io_.out.println("Некорректный выбор. Попробуйте снова.");
+                    print_menu_();
+                }
             }
+        } catch (const end_of_input&) {
         }
         return 0;
     }
@@ -0,0 +1,204 @@
+#pragma once
+
+#ifndef GUAP_ALGO_HASH_TABLE_STATS_H
+#define GUAP_ALGO_HASH_TABLE_STATS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#include "membership_filter.h"
+
+#if defined(GUAP_ALGO_HASH_TABLE_STATS)
+inline constexpr bool hash_table_stats_enabled = true;
+#else
+inline constexpr bool hash_table_stats_enabled = false;
+#endif
+
+inline constexpr size_t probe_histogram_size = 16;
+
+struct hash_table_stats final {
+    std::array<std::uint64_t, probe_histogram_size> probe_histogram = {};
+
+    std::uint64_t hits              = 0;
+    std::uint64_t misses            = 0;
+    std::uint64_t inserts           = 0;
+    std::uint64_t insert_collisions = 0;
+    std::uint64_t removes           = 0;
+
+    std::uint64_t filter_rejects         = 0;
+    std::uint64_t filter_false_positives = 0;
+    filter_stats filter;
+
+    size_t index_bytes = 0;
+
+    size_t items         = 0;
+    size_t longest_chain = 0;
+    std::vector<size_t> occupancy;
+
+    double hit_rate() const {
+        auto lookups = hits + misses;
+        return lookups ? static_cast<double>(hits) / lookups : 0;
+    }
+
+    double avg_probes() const {
+        std::uint64_t lookups = 0;
+        std::uint64_t probes  = 0;
+        for (size_t i = 0; i < probe_histogram.size(); i++) {
+            lookups += probe_histogram[i];
+            probes  += probe_histogram[i] * i;
+        }
+        return lookups ? static_cast<double>(probes) / lookups : 0;
+    }
+
+    double observed_fpr() const {
+        auto negatives = filter_rejects + filter_false_positives;
+        return negatives ? static_cast<double>(filter_false_positives) / negatives : 0;
+    }
+};
+
+struct hash_table_live_counters final {
+private:
+    std::array<std::atomic<std::uint64_t>, probe_histogram_size> probes_ = {};
+
+    std::atomic<std::uint64_t> hits_              = 0;
+    std::atomic<std::uint64_t> misses_            = 0;
+    std::atomic<std::uint64_t> inserts_           = 0;
+    std::atomic<std::uint64_t> insert_collisions_ = 0;
+    std::atomic<std::uint64_t> removes_           = 0;
+
+    std::atomic<std::uint64_t> filter_rejects_         = 0;
+    std::atomic<std::uint64_t> filter_false_positives_ = 0;
+
+    static void bump_(std::atomic<std::uint64_t>& counter) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+public:
+    hash_table_live_counters() = default;
+
+    hash_table_live_counters(const hash_table_live_counters&) {}
+    hash_table_live_counters& operator=(const hash_table_live_counters&) {
+        return *this;
+    }
+
+    void record_lookup(size_t probes, bool hit) {
+        bump_(probes_[std::min(probes, probe_histogram_size - 1)]);
+        bump_(hit ? hits_ : misses_);
+    }
+
+    void record_insert(bool collision) {
+        bump_(inserts_);
+        if (collision) {
+            bump_(insert_collisions_);
+        }
+    }
+
+    void record_remove() {
+        bump_(removes_);
+    }
+
+    void record_filter_reject() {
+        bump_(filter_rejects_);
+    }
+
+    void record_filter_false_positive() {
+        bump_(filter_false_positives_);
+    }
+
+    void fill(hash_table_stats& stats) const {
+        for (size_t i = 0; i < probe_histogram_size; i++) {
+            stats.probe_histogram[i] = probes_[i].load(std::memory_order_relaxed);
+        }
+        stats.hits              = hits_.load(std::memory_order_relaxed);
+        stats.misses            = misses_.load(std::memory_order_relaxed);
+        stats.inserts           = inserts_.load(std::memory_order_relaxed);
+        stats.insert_collisions = insert_collisions_.load(std::memory_order_relaxed);
+        stats.removes           = removes_.load(std::memory_order_relaxed);
+
+        stats.filter_rejects         = filter_rejects_.load(std::memory_order_relaxed);
+        stats.filter_false_positives = filter_false_positives_.load(std::memory_order_relaxed);
+    }
+};
+
+struct hash_table_no_counters final {
+    constexpr void record_lookup(size_t, bool) {}
+    constexpr void record_insert(bool) {}
+    constexpr void record_remove() {}
+    constexpr void record_filter_reject() {}
+    constexpr void record_filter_false_positive() {}
+    constexpr void fill(hash_table_stats&) const {}
+};
+
+using hash_table_counters = std::conditional_t<
+    hash_table_stats_enabled,
+    hash_table_live_counters,
+    hash_table_no_counters>;
+
+inline void write_stats_csv(std::ostream& out, const hash_table_stats& stats) {
+    out << "metric,value\n";
+    out << "items," << stats.items << "\n";
+    out << "hits," << stats.hits << "\n";
+    out << "misses," << stats.misses << "\n";
+    out << "hit_rate," << stats.hit_rate() << "\n";
+    out << "inserts," << stats.inserts << "\n";
+    out << "insert_collisions," << stats.insert_collisions << "\n";
+    out << "removes," << stats.removes << "\n";
+    out << "longest_chain," << stats.longest_chain << "\n";
+    out << "avg_probes," << stats.avg_probes() << "\n";
+    out << "filter_enabled," << stats.filter.enabled << "\n";
+    out << "filter_memory_bytes," << stats.filter.memory_bytes << "\n";
+    out << "filter_hash_count," << stats.filter.hash_count << "\n";
+    out << "filter_target_fpr," << stats.filter.target_fpr << "\n";
+    out << "filter_expected_fpr," << stats.filter.expected_fpr << "\n";
+    out << "filter_rejects," << stats.filter_rejects << "\n";
+    out << "filter_false_positives," << stats.filter_false_positives << "\n";
+    out << "filter_observed_fpr," << stats.observed_fpr() << "\n";
+    out << "index_bytes," << stats.index_bytes << "\n";
+    for (size_t i = 0; i < stats.probe_histogram.size(); i++) {
+        out << "probes_" << i << "," << stats.probe_histogram[i] << "\n";
+    }
+    for (size_t i = 0; i < stats.occupancy.size(); i++) {
+        out << "bucket_" << i << "," << stats.occupancy[i] << "\n";
+    }
+}
+
+inline void write_stats_json(std::ostream& out, const hash_table_stats& stats) {
+    auto write_array = [&out](const auto& values) {
+        out << "[";
+        for (size_t i = 0; i < values.size(); i++) {
+            out << (i ? ", " : "") << values[i];
+        }
+        out << "]";
+    };
+
+    out << "{\n";
+    out << "  \"items\": " << stats.items << ",\n";
+    out << "  \"hits\": " << stats.hits << ",\n";
+    out << "  \"misses\": " << stats.misses << ",\n";
+    out << "  \"hit_rate\": " << stats.hit_rate() << ",\n";
+    out << "  \"inserts\": " << stats.inserts << ",\n";
+    out << "  \"insert_collisions\": " << stats.insert_collisions << ",\n";
+    out << "  \"removes\": " << stats.removes << ",\n";
+    out << "  \"longest_chain\": " << stats.longest_chain << ",\n";
+    out << "  \"avg_probes\": " << stats.avg_probes() << ",\n";
+    out << "  \"filter\": {\"enabled\": " << (stats.filter.enabled ? "true" : "false")
+        << ", \"memory_bytes\": " << stats.filter.memory_bytes
+        << ", \"hash_count\": " << stats.filter.hash_count
+        << ", \"target_fpr\": " << stats.filter.target_fpr
+        << ", \"expected_fpr\": " << stats.filter.expected_fpr
+        << ", \"rejects\": " << stats.filter_rejects
+        << ", \"false_positives\": " << stats.filter_false_positives
+        << ", \"observed_fpr\": " << stats.observed_fpr() << "},\n";
+    out << "  \"index_bytes\": " << stats.index_bytes << ",\n";
+    out << "  \"probe_histogram\": ";
+    write_array(stats.probe_histogram);
+    out << ",\n  \"occupancy\": ";
+    write_array(stats.occupancy);
+    out << "\n}\n";
+}
+
+#endif  // GUAP_ALGO_HASH_TABLE_STATS_H
@@ -0,0 +1,74 @@
+#pragma once
+
+#ifndef GUAP_ALGO_KEY_HASH_H
+#define GUAP_ALGO_KEY_HASH_H
+
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include "packed_key.h"
+#include "small_string.h"
+
+template <typename K>
+struct key_hash : std::hash<K> {};
+
+template <>
+struct key_hash<packed_key> {
+    constexpr size_t operator()(packed_key key) const {
+        return hash_key(key);
+    }
+};
+
+template <std::integral K>
+struct key_hash<K> {
+    constexpr size_t operator()(K key) const {
+        auto h  = static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+        h      ^= h >> 32;
+        return static_cast<size_t>(h);
+    }
+};
+
+template <>
+struct key_hash<small_string> {
+    using is_transparent = void;
+
+    constexpr size_t operator()(std::string_view key) const {
+        std::uint64_t h = 14695981039346656037ull;
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+template <typename K>
+inline constexpr bool caches_hash_v =
+    !std::is_trivially_copyable_v<K> || sizeof(K) > sizeof(size_t);
+
+template <bool Enabled>
+struct cached_hash final {
+    size_t value = 0;
+
+    constexpr void store(size_t hash) {
+        value = hash;
+    }
+
+    constexpr bool matches(size_t hash) const {
+        return value == hash;
+    }
+};
+
+template <>
+struct cached_hash<false> final {
+    constexpr void store(size_t) {}
+
+    constexpr bool matches(size_t) const {
+        return true;
+    }
+};
+
+#endif  // GUAP_ALGO_KEY_HASH_H
@@ -0,0 +1,303 @@
+#pragma once
+
+#ifndef GUAP_ALGO_KEY_INDEX_H
+#define GUAP_ALGO_KEY_INDEX_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "hash_key.h"
+#include "packed_key.h"
+
+struct key_range final {
+    packed_key first;
+    packed_key last;
+};
+
+constexpr std::optional<key_range> prefix_range(std::string_view prefix) {
+    if (prefix.size() > key_size) {
+        return {};
+    }
+
+    std::array<char, key_size> lo = {'A', '0', '0', '0', 'A', 'A'};
+    std::array<char, key_size> hi = {'Z', '9', '9', '9', 'Z', 'Z'};
+    for (size_t i = 0; i < prefix.size(); i++) {
+        if (prefix[i] < lo[i] || prefix[i] > hi[i]) {
+            return {};
+        }
+        lo[i] = prefix[i];
+        hi[i] = prefix[i];
+    }
+    return key_range{packed_key{lo}, packed_key{hi}};
+}
+
+template <typename T>
+struct key_index final {
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    static constexpr size_t leaf_words = (packed_key_count + 63) / 64;
+    static constexpr size_t page_words = 8;
+    static constexpr size_t page_count = (leaf_words + page_words - 1) / page_words;
+
+    struct page final {
+        std::array<std::uint64_t, page_words> words  = {};
+        std::array<std::uint16_t, page_words> before = {};
+        std::vector<T> values;
+    };
+
+    std::vector<std::vector<std::uint64_t>> levels_;
+    std::vector<std::uint32_t> page_of_;
+    std::vector<page> pages_;
+    std::vector<std::uint32_t> free_pages_;
+    size_t size_ = 0;
+
+    static constexpr size_t rank_(std::uint64_t word, size_t bit) {
+        return std::popcount(word & ((std::uint64_t{1} << bit) - 1));
+    }
+
+    constexpr const page* page_(size_t word) const {
+        auto index = page_of_[word / page_words];
+        return index ? &pages_[index - 1] : nullptr;
+    }
+
+    constexpr page& acquire_page_(size_t word) {
+        auto& index = page_of_[word / page_words];
+        if (index == 0) {
+            if (free_pages_.empty()) {
+                if (pages_.size() == pages_.capacity()) {
+                    pages_.reserve(std::min(std::max<size_t>(pages_.size() * 2, 16), page_count));
+                }
+                pages_.emplace_back();
+                index = static_cast<std::uint32_t>(pages_.size());
+            } else {
+                index = free_pages_.back();
+                free_pages_.pop_back();
+            }
+        }
+        return pages_[index - 1];
+    }
+
+    constexpr void release_page_(size_t word) {
+        auto& index = page_of_[word / page_words];
+        auto& freed = pages_[index - 1];
+
+        freed.words  = {};
+        freed.before = {};
+        freed.values = {};
+        free_pages_.push_back(index);
+        index = 0;
+    }
+
+    constexpr std::uint64_t leaf_(size_t word) const {
+        const auto* leaf = page_(word);
+        return leaf ? leaf->words[word % page_words] : 0;
+    }
+
+    constexpr const T& value_(size_t pos) const {
+        const auto& leaf = *page_(pos / 64);
+        auto slot        = pos / 64 % page_words;
+        return leaf.values[leaf.before[slot] + rank_(leaf.words[slot], pos % 64)];
+    }
+
+    constexpr size_t next_word_(size_t level, size_t pos) const {
+        const auto& words = levels_[level];
+        auto word         = pos / 64;
+        if (word >= words.size()) {
+            return npos;
+        }
+
+        if (auto bits = words[word] & (~std::uint64_t{0} << (pos % 64)); bits != 0) {
+            return word * 64 + std::countr_zero(bits);
+        }
+        if (level + 1 == levels_.size()) {
+            return npos;
+        }
+
+        auto next_word = next_word_(level + 1, word + 1);
+        if (next_word == npos) {
+            return npos;
+        }
+        return next_word * 64 + std::countr_zero(words[next_word]);
+    }
+
+    constexpr size_t next_(size_t pos) const {
+        auto word = pos / 64;
+        if (word >= leaf_words) {
+            return npos;
+        }
+        if (auto bits = leaf_(word) & (~std::uint64_t{0} << (pos % 64)); bits != 0) {
+            return word * 64 + std::countr_zero(bits);
+        }
+
+        auto next_word = next_word_(0, word + 1);
+        if (next_word == npos) {
+            return npos;
+        }
+        return next_word * 64 + std::countr_zero(leaf_(next_word));
+    }
+
+    constexpr void mark_(size_t pos) {
+        for (auto& words : levels_) {
+            auto& word = words[pos / 64];
+            bool empty = word == 0;
+            word      |= std::uint64_t{1} << (pos % 64);
+            if (!empty) {
+                return;
+            }
+            pos /= 64;
+        }
+    }
+
+    constexpr void unmark_(size_t pos) {
+        for (auto& words : levels_) {
+            auto& word  = words[pos / 64];
+            word       &= ~(std::uint64_t{1} << (pos % 64));
+            if (word != 0) {
+                return;
+            }
+            pos /= 64;
+        }
+    }
+
+public:
+    void enable() {
+        reset();
+
+        size_t bits = leaf_words;
+        do {
+            bits = (bits + 63) / 64;
+            levels_.emplace_back(bits);
+        } while (bits > 1);
+        page_of_.resize(page_count);
+    }
+
+    void reset() {
+        levels_.clear();
+        page_of_.clear();
+        pages_.clear();
+        free_pages_.clear();
+        size_ = 0;
+    }
+
+    constexpr void clear() {
+        for (auto& words : levels_) {
+            std::ranges::fill(words, 0);
+        }
+        std::ranges::fill(page_of_, 0);
+        pages_.clear();
+        free_pages_.clear();
+        size_ = 0;
+    }
+
+    constexpr bool is_enabled() const {
+        return !levels_.empty();
+    }
+
+    constexpr size_t size() const {
+        return size_;
+    }
+
+    size_t memory_bytes() const {
+        size_t total = page_of_.capacity() * sizeof(std::uint32_t) +
+                       free_pages_.capacity() * sizeof(std::uint32_t) +
+                       pages_.capacity() * sizeof(page);
+        for (const auto& words : levels_) {
+            total += words.capacity() * sizeof(std::uint64_t);
+        }
+        for (const auto& leaf : pages_) {
+            total += leaf.values.capacity() * sizeof(T);
+        }
+        return total;
+    }
+
+    static constexpr bool in_range(packed_key key) {
+        return key.value < packed_key_count;
+    }
+
+    constexpr bool contains(packed_key key) const {
+        return is_enabled() && in_range(key) && (leaf_(key.value / 64) >> (key.value % 64) & 1);
+    }
+
+    constexpr const T* find(packed_key key) const {
+        return contains(key) ? &value_(key.value) : nullptr;
+    }
+
+    constexpr void insert(packed_key key, T value) {
+        auto word  = key.value / 64;
+        auto slot  = word % page_words;
+        auto bit   = std::uint64_t{1} << (key.value % 64);
+        auto& leaf = acquire_page_(word);
+        auto index = leaf.before[slot] + rank_(leaf.words[slot], key.value % 64);
+        if (leaf.words[slot] & bit) {
+            leaf.values[index] = std::move(value);
+            return;
+        }
+
+        leaf.values.insert(leaf.values.begin() + index, std::move(value));
+        for (auto next = slot + 1; next < page_words; next++) {
+            leaf.before[next]++;
+        }
+
+        bool empty        = leaf.words[slot] == 0;
+        leaf.words[slot] |= bit;
+        size_++;
+        if (empty) {
+            mark_(word);
+        }
+    }
+
+    constexpr void erase(packed_key key) {
+        if (!contains(key)) {
+            return;
+        }
+
+        auto word  = key.value / 64;
+        auto slot  = word % page_words;
+        auto& leaf = pages_[page_of_[word / page_words] - 1];
+        auto index = leaf.before[slot] + rank_(leaf.words[slot], key.value % 64);
+
+        leaf.values.erase(leaf.values.begin() + index);
+        for (auto next = slot + 1; next < page_words; next++) {
+            leaf.before[next]--;
+        }
+
+        leaf.words[slot] &= ~(std::uint64_t{1} << (key.value % 64));
+        size_--;
+        if (leaf.words[slot] == 0) {
+            unmark_(word);
+        }
+        if (leaf.values.empty()) {
+            release_page_(word);
+        }
+    }
+
+    constexpr std::optional<packed_key> next(packed_key from) const {
+        auto pos = is_enabled() ? next_(from.value) : npos;
+        if (pos == npos) {
+            return {};
+        }
+        return packed_key{static_cast<std::uint32_t>(pos)};
+    }
+
+    template <typename F>
+    constexpr void scan(key_range range, F&& func) const {
+        if (!is_enabled()) {
+            return;
+        }
+
+        auto pos = next_(range.first.value);
+        while (pos != npos && pos <= range.last.value) {
+            func(packed_key{static_cast<std::uint32_t>(pos)}, value_(pos));
+            pos = next_(pos + 1);
+        }
+    }
+};
+
+#endif  // GUAP_ALGO_KEY_INDEX_H
@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef GUAP_ALGO_KEY_WORKLOAD_H
+#define GUAP_ALGO_KEY_WORKLOAD_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "hash_key.h"
+#include "packed_key.h"
+
+inline packed_key random_key(std::mt19937_64& rng) {
+    return packed_key{static_cast<std::uint32_t>(rng() % packed_key_count)};
+}
+
+inline std::vector<packed_key> sequential_keys(size_t count) {
+    std::vector<packed_key> keys;
+    keys.reserve(count);
+
+    key_gen gen{};
+    while (keys.size() < count) {
+        auto key = gen.next();
+        if (!key.has_value()) {
+            break;
+        }
+        keys.emplace_back(key.value());
+    }
+    return keys;
+}
+
+inline std::vector<packed_key> distinct_random_keys(size_t count, std::mt19937_64& rng) {
+    count = std::min<size_t>(count, packed_key_count);
+
+    std::unordered_set<std::uint32_t> seen;
+    std::vector<packed_key> keys;
+    keys.reserve(count);
+    while (keys.size() < count) {
+        auto key = random_key(rng);
+        if (seen.insert(key.value).second) {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+struct zipf_distribution final {
+private:
+    std::vector<double> cdf_;
+
+public:
+    zipf_distribution(size_t n, double s) {
+        cdf_.resize(n);
+        double sum = 0;
+        for (size_t i = 0; i < n; i++) {
+            sum     += 1.0 / std::pow(static_cast<double>(i + 1), s);
+            cdf_[i]  = sum;
+        }
+        for (auto& v : cdf_) {
+            v /= sum;
+        }
+    }
+
+    size_t operator()(std::mt19937_64& rng) const {
+        auto u  = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        auto it = std::ranges::lower_bound(cdf_, u);
+        return std::min<size_t>(it - cdf_.begin(), cdf_.size() - 1);
+    }
+};
+
+enum class key_distribution {
+    uniform,
+    zipf,
+};
+
+struct key_source final {
+private:
+    std::vector<packed_key> universe_;
+    zipf_distribution zipf_;
+    key_distribution distribution_;
+
+public:
+    key_source(std::vector<packed_key> universe, key_distribution distribution, double zipf_s)
+        : universe_(std::move(universe))
+        , zipf_(universe_.size(), zipf_s)
+        , distribution_(distribution) {}
+
+    packed_key operator()(std::mt19937_64& rng) const {
+        if (distribution_ == key_distribution::zipf) {
+            return universe_[zipf_(rng)];
+        }
+        return universe_[rng() % universe_.size()];
+    }
+};
+
+#endif  // GUAP_ALGO_KEY_WORKLOAD_H
@@ -0,0 +1,159 @@
+#pragma once
+
+#ifndef GUAP_ALGO_MEMBERSHIP_FILTER_H
+#define GUAP_ALGO_MEMBERSHIP_FILTER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+struct filter_config final {
+    size_t capacity            = 1 << 16;
+    double false_positive_rate = 0.01;
+};
+
+struct filter_stats final {
+    bool enabled        = false;
+    size_t capacity     = 0;
+    size_t items        = 0;
+    size_t blocks       = 0;
+    size_t memory_bytes = 0;
+    unsigned hash_count = 0;
+    double target_fpr   = 0;
+    double expected_fpr = 0;
+};
+
+struct counting_bloom_filter final {
+    static constexpr size_t counters_per_block = 128;
+    static constexpr unsigned max_hash_count   = 8;
+    static constexpr std::uint64_t saturated   = 15;
+    static constexpr size_t max_capacity       = size_t{1} << 24;
+    static constexpr double min_fpr            = 1e-6;
+    static constexpr double max_fpr            = 0.5;
+
+private:
+    struct alignas(64) block final {
+        std::uint64_t words[8] = {};
+    };
+
+    std::vector<block> blocks_;
+    unsigned hash_count_ = 0;
+    size_t items_        = 0;
+    filter_config config_;
+
+    static constexpr std::uint64_t mix_(std::uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    struct probe final {
+        size_t block       = 0;
+        std::uint64_t bits = 0;
+    };
+
+    constexpr probe probe_(size_t hash) const {
+        auto h = mix_(hash);
+        return {static_cast<size_t>((h >> 32) * blocks_.size() >> 32), mix_(h)};
+    }
+
+public:
+    void configure(filter_config config) {
+        config.capacity = std::clamp<size_t>(config.capacity, 1, max_capacity);
+        config.false_positive_rate =
+            std::isnan(config.false_positive_rate)
+                ? filter_config{}.false_positive_rate
+                : std::clamp(config.false_positive_rate, min_fpr, max_fpr);
+
+        auto bits_per_key = -std::log(config.false_positive_rate) / (std::log(2.0) * std::log(2.0));
+        auto hash_count   = static_cast<unsigned>(std::lround(bits_per_key * std::log(2.0)));
+
+        config_     = config;
+        hash_count_ = std::clamp(hash_count, 1u, max_hash_count);
+        items_      = 0;
+
+        auto counters = static_cast<size_t>(std::ceil(bits_per_key * config.capacity));
+        auto blocks   = (counters + counters_per_block - 1) / counters_per_block;
+        blocks_.assign(std::max<size_t>(blocks, 1), {});
+    }
+
+    constexpr void reset() {
+        blocks_.clear();
+        hash_count_ = 0;
+        items_      = 0;
+    }
+
+    constexpr void clear() {
+        std::ranges::fill(blocks_, block{});
+        items_ = 0;
+    }
+
+    constexpr bool is_enabled() const {
+        return !blocks_.empty();
+    }
+
+    constexpr void insert(size_t hash) {
+        auto [index, bits] = probe_(hash);
+        auto& words        = blocks_[index].words;
+        for (unsigned i = 0; i < hash_count_; i++, bits >>= 7) {
+            auto counter = bits % counters_per_block;
+            auto shift   = counter % 16 * 4;
+            if ((words[counter / 16] >> shift & saturated) != saturated) {
+                words[counter / 16] += std::uint64_t{1} << shift;
+            }
+        }
+        items_++;
+    }
+
+    constexpr void remove(size_t hash) {
+        auto [index, bits] = probe_(hash);
+        auto& words        = blocks_[index].words;
+        for (unsigned i = 0; i < hash_count_; i++, bits >>= 7) {
+            auto counter = bits % counters_per_block;
+            auto shift   = counter % 16 * 4;
+            auto value   = words[counter / 16] >> shift & saturated;
+            if (value != 0 && value != saturated) {
+                words[counter / 16] -= std::uint64_t{1} << shift;
+            }
+        }
+        items_--;
+    }
+
+    constexpr bool may_contain(size_t hash) const {
+        auto [index, bits] = probe_(hash);
+        const auto& words  = blocks_[index].words;
+
+        bool result = true;
+        for (unsigned i = 0; i < hash_count_; i++, bits >>= 7) {
+            auto counter  = bits % counters_per_block;
+            result       &= (words[counter / 16] >> (counter % 16 * 4) & saturated) != 0;
+        }
+        return result;
+    }
+
+    filter_stats stats() const {
+        filter_stats result;
+        result.enabled = is_enabled();
+        if (!result.enabled) {
+            return result;
+        }
+
+        result.capacity     = config_.capacity;
+        result.items        = items_;
+        result.blocks       = blocks_.size();
+        result.memory_bytes = blocks_.size() * sizeof(block);
+        result.hash_count   = hash_count_;
+        result.target_fpr   = config_.false_positive_rate;
+
+        auto counters       = static_cast<double>(blocks_.size() * counters_per_block);
+        auto fill           = 1 - std::exp(-static_cast<double>(hash_count_ * items_) / counters);
+        result.expected_fpr = std::pow(fill, hash_count_);
+        return result;
+    }
+};
+
+#endif  // GUAP_ALGO_MEMBERSHIP_FILTER_H
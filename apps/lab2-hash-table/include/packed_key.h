@@ -0,0 +1,156 @@
+#pragma once
+
+#ifndef GUAP_ALGO_PACKED_KEY_H
+#define GUAP_ALGO_PACKED_KEY_H
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "hash_key.h"
+
+inline constexpr std::uint32_t packed_letters = 26;
+inline constexpr std::uint32_t packed_digits  = 1000;
+inline constexpr std::uint32_t packed_key_count =
+    packed_letters * packed_digits * packed_letters * packed_letters;
+
+struct packed_key final {
+    std::uint32_t value = 0;
+
+    constexpr packed_key() = default;
+
+    constexpr explicit packed_key(std::uint32_t packed)
+        : value(packed) {}
+
+    constexpr packed_key(std::array<char, key_size> text)
+        : value(
+              ((text[0] - 'A') * packed_digits +
+               ((text[1] - '0') * 100 + (text[2] - '0') * 10 + (text[3] - '0'))) *
+                  packed_letters * packed_letters +
+              (text[4] - 'A') * packed_letters + (text[5] - 'A')
+          ) {}
+
+    constexpr std::array<char, key_size> text() const {
+        auto rest   = value;
+        auto last   = rest % packed_letters;
+        rest       /= packed_letters;
+        auto middle = rest % packed_letters;
+        rest       /= packed_letters;
+        auto digits = rest % packed_digits;
+        auto first  = rest / packed_digits;
+
+        return {
+            static_cast<char>('A' + first),
+            static_cast<char>('0' + digits / 100),
+            static_cast<char>('0' + digits / 10 % 10),
+            static_cast<char>('0' + digits % 10),
+            static_cast<char>('A' + middle),
+            static_cast<char>('A' + last),
+        };
+    }
+
+    std::string str() const {
+        auto chars = text();
+        return {chars.begin(), chars.end()};
+    }
+
+    constexpr auto operator<=>(const packed_key&) const = default;
+};
+
+static_assert(sizeof(packed_key) == sizeof(std::uint32_t));
+
+constexpr size_t hash_key(packed_key key) {
+    return static_cast<size_t>((key.value * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+constexpr std::optional<packed_key> parse_key(std::span<const char, key_size> text) {
+    if consteval {
+        std::array<char, key_size> key = {};
+        for (size_t i = 0; i < key_size; i++) {
+            key[i] = text[i];
+        }
+        if (!is_valid_key(key)) {
+            return {};
+        }
+        return packed_key{key};
+    } else {
+#if defined(__SSE2__)
+        std::uint64_t raw = 0;
+        std::memcpy(&raw, text.data(), key_size);
+
+        const auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&raw));
+        const auto lo = _mm_setr_epi8('A', '0', '0', '0', 'A', 'A', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        const auto hi = _mm_setr_epi8('Z', '9', '9', '9', 'Z', 'Z', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+        auto bad = _mm_or_si128(_mm_cmplt_epi8(bytes, lo), _mm_cmpgt_epi8(bytes, hi));
+        if (_mm_movemask_epi8(bad) != 0) {
+            return {};
+        }
+
+        std::uint64_t lanes = 0;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&lanes), _mm_sub_epi8(bytes, lo));
+
+        auto lane = [lanes](int i) {
+            return static_cast<std::uint32_t>((lanes >> (i * 8)) & 0xFF);
+        };
+
+        return packed_key{
+            ((lane(0) * packed_digits + lane(1) * 100 + lane(2) * 10 + lane(3)) *
+                 packed_letters +
+             lane(4)) *
+                packed_letters +
+            lane(5)
+        };
+#else
+        std::array<char, key_size> key = {};
+        std::memcpy(key.data(), text.data(), key_size);
+        if (!is_valid_key(key)) {
+            return {};
+        }
+        return packed_key{key};
+#endif
+    }
+}
+
+constexpr std::optional<packed_key> parse_key(std::string_view text) {
+    if (text.size() != key_size) {
+        return {};
+    }
+    return parse_key(std::span<const char, key_size>(text.data(), key_size));
+}
+
+constexpr size_t find_key(std::span<const packed_key> keys, packed_key key) {
+    size_t i = 0;
+
+    if !consteval {
+#if defined(__SSE2__)
+        const auto needle = _mm_set1_epi32(static_cast<int>(key.value));
+        for (; i + 4 <= keys.size(); i += 4) {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys.data() + i));
+            auto mask  = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+            if (mask != 0) {
+                return i + std::countr_zero(static_cast<unsigned>(mask));
+            }
+        }
+#endif
+    }
+
+    for (; i < keys.size(); i++) {
+        if (keys[i] == key) {
+            return i;
+        }
+    }
+    return keys.size();
+}
+
+#endif  // GUAP_ALGO_PACKED_KEY_H
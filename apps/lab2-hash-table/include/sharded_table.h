@@ -0,0 +1,124 @@
+#pragma once
+
+#ifndef GUAP_ALGO_SHARDED_TABLE_H
+#define GUAP_ALGO_SHARDED_TABLE_H
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "hash_table.h"
+#include "packed_key.h"
+#include "table_protocol.h"
+
+template <typename V>
+struct sharded_hash_table final {
+    using table_type = hash_table<V>;
+
+private:
+    struct shard final {
+        std::mutex mutex;
+        table_type table;
+    };
+
+    std::vector<std::unique_ptr<shard>> shards_;
+
+    size_t shard_of_(packed_key key) const {
+        return hash_key(key) / table_type::bucket_count % shards_.size();
+    }
+
+    static table_response<V> apply_(table_type& table, const table_request<V>& request) {
+        switch (request.command) {
+            case table_command::get:
+                if (const auto* value = table.find(request.key)) {
+                    return {table_status::found, *value};
+                }
+                return {table_status::missing};
+            case table_command::put:
+                table.insert(request.key, request.value);
+                return {table_status::done};
+            case table_command::remove:
+                if (!table.extract(request.key).is_empty()) {
+                    return {table_status::found};
+                }
+                return {table_status::missing};
+            case table_command::contains:
+                return {table.contains(request.key) ? table_status::found : table_status::missing};
+            default:
+                return {table_status::error};
+        }
+    }
+
+public:
+    explicit sharded_hash_table(size_t shard_count) {
+        shard_count = std::max<size_t>(shard_count, 1);
+        shards_.reserve(shard_count);
+        for (size_t i = 0; i < shard_count; i++) {
+            shards_.push_back(std::make_unique<shard>());
+        }
+    }
+
+    size_t shard_count() const {
+        return shards_.size();
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& s : shards_) {
+            std::lock_guard lock(s->mutex);
+            total += s->table.size();
+        }
+        return total;
+    }
+
+    table_response<V> execute(const table_request<V>& request) {
+        if (request.command == table_command::invalid) {
+            return {table_status::error};
+        }
+
+        auto& s = *shards_[shard_of_(request.key)];
+        std::lock_guard lock(s.mutex);
+        return apply_(s.table, request);
+    }
+
+    void execute(
+        std::span<const table_request<V>> requests,
+        std::span<table_response<V>> responses,
+        std::vector<size_t>& order
+    ) {
+        order.resize(requests.size());
+        for (size_t i = 0; i < requests.size(); i++) {
+            order[i] = i;
+        }
+
+        auto shard_of = [this, &requests](size_t i) {
+            return requests[i].command == table_command::invalid ? shards_.size()
+                                                                 : shard_of_(requests[i].key);
+        };
+        std::ranges::stable_sort(order, {}, shard_of);
+
+        for (auto first = order.begin(); first != order.end();) {
+            auto index = shard_of(*first);
+            auto last  = std::find_if(first, order.end(), [&](size_t i) {
+                return shard_of(i) != index;
+            });
+
+            if (index == shards_.size()) {
+                for (auto it = first; it != last; ++it) {
+                    responses[*it] = {table_status::error};
+                }
+            } else {
+                auto& s = *shards_[index];
+                std::lock_guard lock(s.mutex);
+                for (auto it = first; it != last; ++it) {
+                    responses[*it] = apply_(s.table, requests[*it]);
+                }
+            }
+            first = last;
+        }
+    }
+};
+
+#endif  // GUAP_ALGO_SHARDED_TABLE_H
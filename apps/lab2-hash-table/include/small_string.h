@@ -0,0 +1,125 @@
+#pragma once
+
+#ifndef GUAP_ALGO_SMALL_STRING_H
+#define GUAP_ALGO_SMALL_STRING_H
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+struct small_string final {
+    static constexpr size_t inline_capacity = 15;
+
+private:
+    std::uint32_t size_ = 0;
+    union {
+        char inline_[inline_capacity + 1];
+        char* heap_;
+    };
+
+    bool is_inline_() const {
+        return size_ <= inline_capacity;
+    }
+
+    void assign_(std::string_view text) {
+        size_ = static_cast<std::uint32_t>(text.size());
+        if (is_inline_()) {
+            std::memcpy(inline_, text.data(), text.size());
+            inline_[text.size()] = '\0';
+        } else {
+            heap_ = new char[text.size() + 1];
+            std::memcpy(heap_, text.data(), text.size());
+            heap_[text.size()] = '\0';
+        }
+    }
+
+    void release_() {
+        if (!is_inline_()) {
+            delete[] heap_;
+        }
+        size_      = 0;
+        inline_[0] = '\0';
+    }
+
+public:
+    small_string()
+        : inline_{} {}
+
+    small_string(std::string_view text) {
+        assign_(text);
+    }
+
+    small_string(const char* text)
+        : small_string(std::string_view(text)) {}
+
+    ~small_string() {
+        release_();
+    }
+
+    small_string(const small_string& rhs) {
+        assign_(rhs.view());
+    }
+
+    small_string& operator=(const small_string& rhs) {
+        if (this != &rhs) {
+            release_();
+            assign_(rhs.view());
+        }
+        return *this;
+    }
+
+    small_string(small_string&& rhs) noexcept
+        : small_string() {
+        *this = std::move(rhs);
+    }
+
+    small_string& operator=(small_string&& rhs) noexcept {
+        if (this == &rhs) {
+            return *this;
+        }
+
+        release_();
+        if (rhs.is_inline_()) {
+            assign_(rhs.view());
+        } else {
+            size_ = std::exchange(rhs.size_, 0);
+            heap_ = rhs.heap_;
+            rhs.inline_[0] = '\0';
+        }
+        return *this;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    const char* data() const {
+        return is_inline_() ? inline_ : heap_;
+    }
+
+    std::string_view view() const {
+        return {data(), size_};
+    }
+
+    std::string str() const {
+        return std::string(view());
+    }
+
+    operator std::string_view() const {
+        return view();
+    }
+
+    friend bool operator==(const small_string& lhs, std::string_view rhs) {
+        return lhs.view() == rhs;
+    }
+
+    friend std::strong_ordering operator<=>(const small_string& lhs, std::string_view rhs) {
+        return lhs.view() <=> rhs;
+    }
+};
+
+#endif  // GUAP_ALGO_SMALL_STRING_H
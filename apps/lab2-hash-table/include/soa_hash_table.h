@@ -0,0 +1,232 @@
+#pragma once
+
+#ifndef GUAP_ALGO_SOA_HASH_TABLE_H
+#define GUAP_ALGO_SOA_HASH_TABLE_H
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "hash_key.h"
+#include "hash_table_stats.h"
+#include "key_hash.h"
+#include "packed_key.h"
+
+template <
+    typename K,
+    typename V,
+    typename Hash     = key_hash<K>,
+    typename KeyEqual = std::equal_to<>>
+struct basic_soa_hash_table final {
+    static constexpr size_t bucket_count = 1500;
+    static constexpr bool uses_tags      = caches_hash_v<K>;
+
+    using key_type    = K;
+    using mapped_type = V;
+    using hasher      = Hash;
+    using key_equal   = KeyEqual;
+
+    struct bucket_type final {
+        std::vector<std::uint8_t> tags;
+        std::vector<K> keys;
+        std::vector<V> values;
+
+        constexpr size_t size() const {
+            return keys.size();
+        }
+
+        constexpr bool is_empty() const {
+            return keys.empty();
+        }
+    };
+
+private:
+    bucket_type buckets_[bucket_count] = {};
+    size_t size_                       = 0;
+
+    [[no_unique_address]] Hash hash_      = {};
+    [[no_unique_address]] KeyEqual equal_ = {};
+
+    [[no_unique_address]] mutable hash_table_counters counters_ = {};
+
+    static constexpr std::uint8_t tag_of_(size_t hash) {
+        return static_cast<std::uint8_t>(hash >> (8 * sizeof(size_t) - 8)) | 1;
+    }
+
+    constexpr size_t find_(
+        const bucket_type& bucket,
+        const K& key,
+        size_t hash,
+        bool lookup = false
+    ) const {
+        size_t index = bucket.size();
+        if constexpr (std::same_as<K, packed_key>) {
+            index = find_key(bucket.keys, key);
+        } else if constexpr (uses_tags) {
+            auto tag = tag_of_(hash);
+            for (size_t i = 0; i < bucket.size(); i++) {
+                if (bucket.tags[i] == tag && equal_(bucket.keys[i], key)) {
+                    index = i;
+                    break;
+                }
+            }
+        } else {
+            for (size_t i = 0; i < bucket.size(); i++) {
+                if (equal_(bucket.keys[i], key)) {
+                    index = i;
+                    break;
+                }
+            }
+        }
+
+        if !consteval {
+            if (lookup) {
+                counters_.record_lookup(std::min(index + 1, bucket.size()), index != bucket.size());
+            }
+        }
+        return index;
+    }
+
+    constexpr V& emplace_(bucket_type& bucket, const K& key, V value, size_t hash) {
+        if constexpr (uses_tags) {
+            bucket.tags.push_back(tag_of_(hash));
+        }
+        bucket.keys.push_back(key);
+        bucket.values.push_back(std::move(value));
+
+        size_++;
+        if !consteval {
+            counters_.record_insert(bucket.size() > 1);
+        }
+        return bucket.values.back();
+    }
+
+    constexpr void erase_(bucket_type& bucket, size_t index) {
+        if constexpr (uses_tags) {
+            bucket.tags[index] = bucket.tags.back();
+            bucket.tags.pop_back();
+        }
+        bucket.keys[index]   = std::move(bucket.keys.back());
+        bucket.values[index] = std::move(bucket.values.back());
+        bucket.keys.pop_back();
+        bucket.values.pop_back();
+
+        size_--;
+        if !consteval {
+            counters_.record_remove();
+        }
+    }
+
+public:
+    constexpr size_t bucket_of(const K& key) const {
+        return hash_(key) % bucket_count;
+    }
+
+    constexpr size_t size() const {
+        return size_;
+    }
+
+    constexpr V& operator[](const K& key) {
+        auto hash    = hash_(key);
+        auto& bucket = buckets_[hash % bucket_count];
+        if (auto index = find_(bucket, key, hash); index != bucket.size()) {
+            return bucket.values[index];
+        }
+        return emplace_(bucket, key, V{}, hash);
+    }
+
+    constexpr const V& operator[](const K& key) const {
+        if (const auto* value = find(key)) {
+            return *value;
+        }
+        throw std::out_of_range("key not found");
+    }
+
+    constexpr void insert(const K& key, V value) {
+        auto hash    = hash_(key);
+        auto& bucket = buckets_[hash % bucket_count];
+        if (auto index = find_(bucket, key, hash); index != bucket.size()) {
+            bucket.values[index] = std::move(value);
+            return;
+        }
+        emplace_(bucket, key, std::move(value), hash);
+    }
+
+    constexpr bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    constexpr V* find(const K& key) {
+        return const_cast<V*>(std::as_const(*this).find(key));
+    }
+
+    constexpr const V* find(const K& key) const {
+        auto hash          = hash_(key);
+        const auto& bucket = buckets_[hash % bucket_count];
+        if (auto index = find_(bucket, key, hash, true); index != bucket.size()) {
+            return &bucket.values[index];
+        }
+        return nullptr;
+    }
+
+    constexpr void remove(const K& key) {
+        auto hash    = hash_(key);
+        auto& bucket = buckets_[hash % bucket_count];
+        if (auto index = find_(bucket, key, hash); index != bucket.size()) {
+            erase_(bucket, index);
+        }
+    }
+
+    constexpr void clear() {
+        for (auto& bucket : buckets_) {
+            bucket.tags.clear();
+            bucket.keys.clear();
+            bucket.values.clear();
+        }
+        size_ = 0;
+    }
+
+    constexpr void reserve_bucket(size_t index, size_t count) {
+        if constexpr (uses_tags) {
+            buckets_[index].tags.reserve(count);
+        }
+        buckets_[index].keys.reserve(count);
+        buckets_[index].values.reserve(count);
+    }
+
+    hash_table_stats stats() const {
+        hash_table_stats result;
+        counters_.fill(result);
+
+        result.items = size_;
+        result.occupancy.resize(bucket_count);
+        for (size_t i = 0; i < bucket_count; i++) {
+            result.occupancy[i]  = buckets_[i].size();
+            result.longest_chain = std::max(result.longest_chain, buckets_[i].size());
+        }
+        return result;
+    }
+
+    size_t memory_bytes() const {
+        size_t total = sizeof(*this);
+        for (const auto& bucket : buckets_) {
+            total += bucket.tags.capacity() + bucket.keys.capacity() * sizeof(K) +
+                     bucket.values.capacity() * sizeof(V);
+        }
+        return total;
+    }
+
+    constexpr const bucket_type& bucket(size_t index) const {
+        return buckets_[index];
+    }
+};
+
+template <typename V>
+using soa_hash_table = basic_soa_hash_table<packed_key, V>;
+
+#endif  // GUAP_ALGO_SOA_HASH_TABLE_H
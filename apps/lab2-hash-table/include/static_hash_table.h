@@ -0,0 +1,92 @@
+#pragma once
+
+#ifndef GUAP_ALGO_STATIC_HASH_TABLE_H
+#define GUAP_ALGO_STATIC_HASH_TABLE_H
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "hash_key.h"
+#include "hash_table.h"
+#include "packed_key.h"
+
+template <typename V, size_t N, size_t BucketCount = hash_table<V>::bucket_count>
+struct static_hash_table final {
+    static constexpr size_t bucket_count = BucketCount;
+
+    using key_type = packed_key;
+
+private:
+    std::array<key_type, N> keys_                        = {};
+    std::array<V, N> values_                             = {};
+    std::array<std::uint32_t, bucket_count + 1> offsets_ = {};
+
+    static constexpr size_t bucket_by_key_(key_type key) {
+        return hash_key(key) % bucket_count;
+    }
+
+    constexpr size_t find_(key_type key) const {
+        auto index = bucket_by_key_(key);
+        auto keys  = bucket_keys(index);
+        if (auto pos = find_key(keys, key); pos != keys.size()) {
+            return offsets_[index] + pos;
+        }
+        return N;
+    }
+
+public:
+    consteval static_hash_table(const std::pair<key_type, V> (&entries)[N]) {
+        for (const auto& [key, value] : entries) {
+            if (key.value >= packed_key_count) {
+                throw std::invalid_argument("invalid key format");
+            }
+            offsets_[bucket_by_key_(key) + 1]++;
+        }
+        for (size_t i = 0; i < bucket_count; i++) {
+            offsets_[i + 1] += offsets_[i];
+        }
+
+        auto cursor = offsets_;
+        for (const auto& [key, value] : entries) {
+            auto index = bucket_by_key_(key);
+            for (auto i = offsets_[index]; i < cursor[index]; i++) {
+                if (keys_[i] == key) {
+                    throw std::invalid_argument("duplicate key");
+                }
+            }
+            keys_[cursor[index]]     = key;
+            values_[cursor[index]++] = value;
+        }
+    }
+
+    constexpr size_t size() const {
+        return N;
+    }
+
+    constexpr bool contains(key_type key) const {
+        return find_(key) != N;
+    }
+
+    constexpr const V& operator[](key_type key) const {
+        if (auto found = find_(key); found != N) {
+            return values_[found];
+        }
+        throw std::out_of_range("key not found");
+    }
+
+    constexpr std::span<const key_type> bucket_keys(size_t index) const {
+        return std::span(keys_).subspan(offsets_[index], offsets_[index + 1] - offsets_[index]);
+    }
+};
+
+template <typename V, size_t N>
+consteval static_hash_table<V, N> make_static_hash_table(
+    const std::pair<packed_key, V> (&entries)[N]
+) {
+    return static_hash_table<V, N>(entries);
+}
+
+#endif  // GUAP_ALGO_STATIC_HASH_TABLE_H
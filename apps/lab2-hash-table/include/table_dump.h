@@ -0,0 +1,326 @@
+#pragma once
+
+#ifndef GUAP_ALGO_TABLE_DUMP_H
+#define GUAP_ALGO_TABLE_DUMP_H
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#if defined(GUAP_ALGO_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+#include "packed_key.h"
+#include "work_stealing_pool.h"
+
+#if defined(GUAP_ALGO_HAS_ZLIB)
+inline constexpr bool dump_gzip_supported = true;
+#else
+inline constexpr bool dump_gzip_supported = false;
+#endif
+
+enum class dump_compression {
+    none,
+    gzip,
+};
+
+struct dump_file_sink final {
+private:
+#if defined(__unix__) || defined(__APPLE__)
+    int fd_ = -1;
+#else
+    std::ofstream file_;
+#endif
+
+public:
+    explicit dump_file_sink(const std::filesystem::path& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#else
+        file_.open(path, std::ios::out | std::ios::binary);
+#endif
+    }
+
+    dump_file_sink(const dump_file_sink&)            = delete;
+    dump_file_sink& operator=(const dump_file_sink&) = delete;
+
+    ~dump_file_sink() {
+        close();
+    }
+
+    bool is_open() const {
+#if defined(__unix__) || defined(__APPLE__)
+        return fd_ >= 0;
+#else
+        return file_.is_open();
+#endif
+    }
+
+    bool write(std::span<const std::string> buffers) {
+#if defined(__unix__) || defined(__APPLE__)
+        std::vector<iovec> iov;
+        iov.reserve(buffers.size());
+        for (const auto& buffer : buffers) {
+            if (!buffer.empty()) {
+                iov.push_back({const_cast<char*>(buffer.data()), buffer.size()});
+            }
+        }
+
+        size_t first = 0;
+        while (first < iov.size()) {
+            auto count   = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+            auto written = ::writev(fd_, iov.data() + first, count);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+
+            auto left = static_cast<size_t>(written);
+            while (first < iov.size() && left >= iov[first].iov_len) {
+                left -= iov[first].iov_len;
+                first++;
+            }
+            if (left > 0) {
+                iov[first].iov_base  = static_cast<char*>(iov[first].iov_base) + left;
+                iov[first].iov_len  -= left;
+            }
+        }
+        return true;
+#else
+        for (const auto& buffer : buffers) {
+            file_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+        return static_cast<bool>(file_);
+#endif
+    }
+
+    bool close() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (fd_ < 0) {
+            return true;
+        }
+        return ::close(std::exchange(fd_, -1)) == 0;
+#else
+        file_.close();
+        return !file_.fail();
+#endif
+    }
+};
+
+struct dump_gzip_sink final {
+private:
+#if defined(GUAP_ALGO_HAS_ZLIB)
+    gzFile file_ = nullptr;
+#endif
+
+public:
+    explicit dump_gzip_sink([[maybe_unused]] const std::filesystem::path& path) {
+#if defined(GUAP_ALGO_HAS_ZLIB)
+        file_ = ::gzopen(path.string().c_str(), "wb");
+#endif
+    }
+
+    dump_gzip_sink(const dump_gzip_sink&)            = delete;
+    dump_gzip_sink& operator=(const dump_gzip_sink&) = delete;
+
+    ~dump_gzip_sink() {
+        close();
+    }
+
+    bool is_open() const {
+#if defined(GUAP_ALGO_HAS_ZLIB)
+        return file_ != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    bool write([[maybe_unused]] std::span<const std::string> buffers) {
+#if defined(GUAP_ALGO_HAS_ZLIB)
+        for (const auto& buffer : buffers) {
+            std::string_view rest = buffer;
+            while (!rest.empty()) {
+                auto count   = static_cast<unsigned>(std::min<size_t>(rest.size(), 1 << 30));
+                auto written = ::gzwrite(file_, rest.data(), count);
+                if (written <= 0) {
+                    return false;
+                }
+                rest.remove_prefix(static_cast<size_t>(written));
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool close() {
+#if defined(GUAP_ALGO_HAS_ZLIB)
+        if (!file_) {
+            return true;
+        }
+        return ::gzclose(std::exchange(file_, nullptr)) == Z_OK;
+#else
+        return true;
+#endif
+    }
+};
+
+struct table_dump_engine final {
+private:
+    work_stealing_pool pool_;
+    size_t buckets_per_chunk_;
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    static void append_(std::string& out, T value) {
+        char buffer[32];
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, end);
+    }
+
+    static void append_(std::string& out, packed_key key) {
+        auto text = key.text();
+        out.append(text.data(), text.size());
+    }
+
+    static void append_(std::string& out, std::string_view text) {
+        out.append(text);
+    }
+
+    template <typename Table>
+    static constexpr bool is_dense_ = requires(const Table& table) { table.entries(); };
+
+    static constexpr size_t entries_per_chunk_ = 4096;
+
+    template <typename Table>
+    size_t chunk_count_(const Table& table) const {
+        if constexpr (is_dense_<Table>) {
+            return (table.size() + entries_per_chunk_ - 1) / entries_per_chunk_;
+        } else {
+            return (Table::bucket_count + buckets_per_chunk_ - 1) / buckets_per_chunk_;
+        }
+    }
+
+    template <typename Table>
+    void format_entries_(const Table& table, size_t chunk, std::string& out) const {
+        auto entries = table.entries();
+        auto first   = chunk * entries_per_chunk_;
+        auto count   = std::min(entries_per_chunk_, entries.size() - first);
+        out.reserve(count * 32);
+
+        for (auto i = first; i < first + count; i++) {
+            const auto& it = entries[i];
+            append_(out, i);
+            out += ',';
+            append_(out, it.key);
+            out += ',';
+            append_(out, it.value);
+            out += '\n';
+        }
+    }
+
+    template <typename Table>
+    void format_buckets_(const Table& table, size_t chunk, std::string& out) const {
+        auto first = chunk * buckets_per_chunk_;
+        auto last  = std::min(Table::bucket_count, first + buckets_per_chunk_);
+
+        size_t items = 0;
+        for (auto i = first; i < last; i++) {
+            items += table.bucket(i).size();
+        }
+        out.reserve(items * 32);
+
+        for (auto i = first; i < last; i++) {
+            for (const auto& it : table.bucket(i)) {
+                append_(out, i);
+                out += ',';
+                append_(out, it.key);
+                out += ',';
+                append_(out, it.value);
+                out += '\n';
+            }
+        }
+    }
+
+    template <typename Table>
+    void format_chunk_(const Table& table, size_t chunk, std::string& out) const {
+        out.clear();
+        if constexpr (is_dense_<Table>) {
+            format_entries_(table, chunk, out);
+        } else {
+            format_buckets_(table, chunk, out);
+        }
+    }
+
+    template <typename Table, typename Sink>
+    bool dump_to_(const Table& table, Sink& sink) {
+        if (!sink.is_open()) {
+            return false;
+        }
+
+        auto chunks = chunk_count_(table);
+        auto round  = std::min(chunks, 2 * pool_.thread_count());
+
+        std::vector<std::string> buffers(round);
+        for (size_t first = 0; first < chunks; first += round) {
+            auto count = std::min(round, chunks - first);
+
+            task_group group;
+            for (size_t i = 0; i < count; i++) {
+                pool_.submit(group, [this, &table, &buffers, first, i] {
+                    format_chunk_(table, first + i, buffers[i]);
+                });
+            }
+            pool_.wait(group);
+
+            if (!sink.write(std::span<const std::string>(buffers).first(count))) {
+                return false;
+            }
+        }
+        return sink.close();
+    }
+
+public:
+    explicit table_dump_engine(
+        size_t thread_count      = std::thread::hardware_concurrency(),
+        size_t buckets_per_chunk = 64
+    )
+        : pool_(thread_count)
+        , buckets_per_chunk_(std::max<size_t>(buckets_per_chunk, 1)) {}
+
+    template <typename Table>
+    bool dump_csv(
+        const Table& table,
+        const std::filesystem::path& path,
+        dump_compression compression = dump_compression::none
+    ) {
+        if (compression == dump_compression::gzip) {
+            dump_gzip_sink sink(path);
+            return dump_to_(table, sink);
+        }
+        dump_file_sink sink(path);
+        return dump_to_(table, sink);
+    }
+};
+
+#endif  // GUAP_ALGO_TABLE_DUMP_H
@@ -0,0 +1,167 @@
+#pragma once
+
+#ifndef GUAP_ALGO_TABLE_PROTOCOL_H
+#define GUAP_ALGO_TABLE_PROTOCOL_H
+
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include "packed_key.h"
+
+enum class table_command {
+    invalid,
+    get,
+    put,
+    remove,
+    contains,
+};
+
+enum class table_status {
+    found,
+    missing,
+    done,
+    error,
+};
+
+template <typename V>
+struct table_request final {
+    table_command command = table_command::invalid;
+    packed_key key        = {};
+    V value               = {};
+};
+
+template <typename V>
+struct table_response final {
+    table_status status = table_status::error;
+    V value             = {};
+};
+
+inline std::string_view next_token(std::string_view& text) {
+    auto begin = text.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+        text = {};
+        return {};
+    }
+    auto end   = std::min(text.find(' ', begin), text.size());
+    auto token = text.substr(begin, end - begin);
+    text.remove_prefix(end);
+    return token;
+}
+
+template <typename V>
+table_request<V> parse_request(std::string_view line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    table_request<V> request;
+
+    auto name = next_token(line);
+    auto key  = parse_key(next_token(line));
+    if (!key.has_value()) {
+        return request;
+    }
+    request.key = key.value();
+
+    if (name == "get") {
+        request.command = table_command::get;
+    } else if (name == "del") {
+        request.command = table_command::remove;
+    } else if (name == "has") {
+        request.command = table_command::contains;
+    } else if (name == "put") {
+        auto value        = next_token(line);
+        auto last         = value.data() + value.size();
+        auto [end, error] = std::from_chars(value.data(), last, request.value);
+        if (value.empty() || error != std::errc{} || end != last) {
+            return request;
+        }
+        request.command = table_command::put;
+    } else {
+        return request;
+    }
+
+    return next_token(line).empty() ? request : table_request<V>{};
+}
+
+template <typename V>
+void append_request(std::string& out, const table_request<V>& request) {
+    switch (request.command) {
+        case table_command::get:
+            out += "get ";
+            break;
+        case table_command::put:
+            out += "put ";
+            break;
+        case table_command::remove:
+            out += "del ";
+            break;
+        case table_command::contains:
+            out += "has ";
+            break;
+        default:
+            out += "bad\n";
+            return;
+    }
+
+    auto text = request.key.text();
+    out.append(text.data(), text.size());
+    if (request.command == table_command::put) {
+        char buffer[32];
+        auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), request.value);
+        out += ' ';
+        out.append(buffer, end);
+    }
+    out += '\n';
+}
+
+template <typename V>
+void append_response(std::string& out, table_command command, const table_response<V>& response) {
+    switch (response.status) {
+        case table_status::found:
+            out += '+';
+            if (command == table_command::get) {
+                char buffer[32];
+                auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), response.value);
+                out.append(buffer, end);
+            }
+            break;
+        case table_status::done:
+            out += '+';
+            break;
+        case table_status::missing:
+            out += '-';
+            break;
+        default:
+            out += '!';
+            break;
+    }
+    out += '\n';
+}
+
+template <typename V>
+table_response<V> parse_response(std::string_view line) {
+    table_response<V> response;
+    if (line.empty()) {
+        return response;
+    }
+
+    switch (line.front()) {
+        case '+':
+            response.status = table_status::found;
+            if (line.size() > 1) {
+                std::from_chars(line.data() + 1, line.data() + line.size(), response.value);
+            }
+            break;
+        case '-':
+            response.status = table_status::missing;
+            break;
+        default:
+            break;
+    }
+    return response;
+}
+
+#endif  // GUAP_ALGO_TABLE_PROTOCOL_H
@@ -0,0 +1,391 @@
+#pragma once
+
+#ifndef GUAP_ALGO_TABLE_SERVER_H
+#define GUAP_ALGO_TABLE_SERVER_H
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sharded_table.h"
+#include "table_protocol.h"
+
+struct socket_endpoint final {
+    std::string unix_path;
+    std::uint16_t port = 0;
+
+private:
+    sockaddr_un unix_address_() const {
+        sockaddr_un address = {};
+        address.sun_family  = AF_UNIX;
+        std::strncpy(address.sun_path, unix_path.c_str(), sizeof(address.sun_path) - 1);
+        return address;
+    }
+
+    sockaddr_in inet_address_() const {
+        sockaddr_in address     = {};
+        address.sin_family      = AF_INET;
+        address.sin_port        = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return address;
+    }
+
+public:
+    bool is_unix() const {
+        return !unix_path.empty();
+    }
+
+    int listen() const {
+        int fd = is_unix() ? ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0)
+                           : ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (fd < 0) {
+            return -1;
+        }
+
+        int result = 0;
+        if (is_unix()) {
+            ::unlink(unix_path.c_str());
+            auto address = unix_address_();
+            result       = ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        } else {
+            int reuse = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            auto address = inet_address_();
+            result       = ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        }
+
+        if (result < 0 || ::listen(fd, SOMAXCONN) < 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    int connect() const {
+        int fd = is_unix() ? ::socket(AF_UNIX, SOCK_STREAM, 0) : ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+
+        int result = 0;
+        if (is_unix()) {
+            auto address = unix_address_();
+            result       = ::connect(
+                fd,
+                reinterpret_cast<const sockaddr*>(&address),
+                sizeof(address)
+            );
+        } else {
+            int no_delay = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+            auto address = inet_address_();
+            result       = ::connect(
+                fd,
+                reinterpret_cast<const sockaddr*>(&address),
+                sizeof(address)
+            );
+        }
+
+        if (result < 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+};
+
+template <typename V>
+struct table_server final {
+private:
+    struct connection final {
+        int fd = -1;
+        std::string input;
+        std::string output;
+        size_t written       = 0;
+        std::uint32_t events = EPOLLIN | EPOLLRDHUP;
+        bool draining        = false;
+    };
+
+    struct event_loop final {
+        int epoll_fd   = -1;
+        bool accepting = false;
+        std::unordered_map<int, connection> connections;
+
+        std::vector<table_request<V>> requests;
+        std::vector<table_response<V>> responses;
+        std::vector<size_t> order;
+    };
+
+    sharded_hash_table<V>& table_;
+    socket_endpoint endpoint_;
+    size_t thread_count_;
+
+    int listen_fd_ = -1;
+    int stop_fd_   = -1;
+
+    std::atomic<std::uint64_t> served_ = 0;
+
+    static constexpr size_t read_size         = 64 * 1024;
+    static constexpr size_t max_line_size     = 4 * 1024;
+    static constexpr size_t input_limit       = 1024 * 1024;
+    static constexpr size_t output_high_water = 4 * 1024 * 1024;
+    static constexpr int max_events           = 256;
+    static constexpr int accept_retry_ms      = 100;
+
+    void close_(event_loop& loop, int fd) {
+        ::epoll_ctl(loop.epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        loop.connections.erase(fd);
+    }
+
+    void watch_listen_(event_loop& loop, bool enable) {
+        epoll_event event = {};
+        event.events      = EPOLLIN | EPOLLEXCLUSIVE;
+        event.data.fd     = listen_fd_;
+        ::epoll_ctl(loop.epoll_fd, enable ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, listen_fd_, &event);
+        loop.accepting = enable;
+    }
+
+    void accept_(event_loop& loop) {
+        while (true) {
+            int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                    watch_listen_(loop, false);
+                }
+                return;
+            }
+            if (!endpoint_.is_unix()) {
+                int no_delay = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+            }
+
+            epoll_event event = {};
+            event.events      = EPOLLIN | EPOLLRDHUP;
+            event.data.fd     = fd;
+            ::epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, fd, &event);
+            loop.connections[fd].fd = fd;
+        }
+    }
+
+    bool process_(event_loop& loop, connection& conn) {
+        loop.requests.clear();
+
+        size_t consumed = 0;
+        while (true) {
+            auto end = conn.input.find('\n', consumed);
+            if (end == std::string::npos) {
+                break;
+            }
+            auto line = std::string_view(conn.input).substr(consumed, end - consumed);
+            loop.requests.push_back(parse_request<V>(line));
+            consumed = end + 1;
+        }
+        conn.input.erase(0, consumed);
+        if (conn.input.size() > max_line_size) {
+            return false;
+        }
+
+        if (loop.requests.empty()) {
+            return true;
+        }
+
+        loop.responses.resize(loop.requests.size());
+        table_.execute(loop.requests, loop.responses, loop.order);
+        for (size_t i = 0; i < loop.requests.size(); i++) {
+            append_response(conn.output, loop.requests[i].command, loop.responses[i]);
+        }
+        served_.fetch_add(loop.requests.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    bool flush_(event_loop& loop, connection& conn) {
+        while (conn.written < conn.output.size()) {
+            auto result = ::send(
+                conn.fd,
+                conn.output.data() + conn.written,
+                conn.output.size() - conn.written,
+                MSG_NOSIGNAL
+            );
+            if (result < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                return false;
+            }
+            conn.written += static_cast<size_t>(result);
+        }
+
+        if (conn.written == conn.output.size()) {
+            conn.output.clear();
+            conn.written = 0;
+        }
+
+        std::uint32_t events = 0;
+        if (!conn.draining && conn.output.size() - conn.written < output_high_water) {
+            events |= EPOLLIN | EPOLLRDHUP;
+        }
+        if (!conn.output.empty()) {
+            events |= EPOLLOUT;
+        }
+
+        if (events != conn.events) {
+            conn.events       = events;
+            epoll_event event = {};
+            event.events      = events;
+            event.data.fd     = conn.fd;
+            ::epoll_ctl(loop.epoll_fd, EPOLL_CTL_MOD, conn.fd, &event);
+        }
+        return true;
+    }
+
+    bool read_(connection& conn) {
+        char buffer[read_size];
+        while (conn.input.size() < input_limit) {
+            auto result = ::recv(conn.fd, buffer, sizeof(buffer), 0);
+            if (result > 0) {
+                conn.input.append(buffer, static_cast<size_t>(result));
+                continue;
+            }
+            if (result == 0) {
+                conn.draining = true;
+                return true;
+            }
+            if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return true;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    void run_loop_(event_loop& loop) {
+        epoll_event events[max_events];
+        while (true) {
+            int timeout = loop.accepting ? -1 : accept_retry_ms;
+            int count   = ::epoll_wait(loop.epoll_fd, events, max_events, timeout);
+            if (count < 0 && errno != EINTR) {
+                return;
+            }
+            if (!loop.accepting) {
+                watch_listen_(loop, true);
+            }
+
+            for (int i = 0; i < count; i++) {
+                int fd = events[i].data.fd;
+                if (fd == stop_fd_) {
+                    return;
+                }
+                if (fd == listen_fd_) {
+                    accept_(loop);
+                    continue;
+                }
+
+                auto it = loop.connections.find(fd);
+                if (it == loop.connections.end()) {
+                    continue;
+                }
+                auto& conn = it->second;
+
+                bool alive = true;
+                auto ready = events[i].events;
+                if (ready & (EPOLLHUP | EPOLLERR)) {
+                    alive = false;
+                } else if ((conn.events & EPOLLIN) && (ready & (EPOLLIN | EPOLLRDHUP))) {
+                    alive = read_(conn);
+                    alive = process_(loop, conn) && alive;
+                }
+                if (!alive || !flush_(loop, conn) || (conn.draining && conn.output.empty())) {
+                    close_(loop, fd);
+                }
+            }
+        }
+    }
+
+public:
+    table_server(sharded_hash_table<V>& table, socket_endpoint endpoint, size_t thread_count)
+        : table_(table)
+        , endpoint_(std::move(endpoint))
+        , thread_count_(std::max<size_t>(thread_count, 1)) {}
+
+    table_server(const table_server&)            = delete;
+    table_server& operator=(const table_server&) = delete;
+
+    ~table_server() {
+        if (listen_fd_ >= 0) {
+            ::close(listen_fd_);
+        }
+        if (stop_fd_ >= 0) {
+            ::close(stop_fd_);
+        }
+        if (endpoint_.is_unix()) {
+            ::unlink(endpoint_.unix_path.c_str());
+        }
+    }
+
+    bool open() {
+        listen_fd_ = endpoint_.listen();
+        stop_fd_   = ::eventfd(0, EFD_NONBLOCK);
+        return listen_fd_ >= 0 && stop_fd_ >= 0;
+    }
+
+    void stop() {
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto result = ::write(stop_fd_, &one, sizeof(one));
+    }
+
+    std::uint64_t served() const {
+        return served_.load(std::memory_order_relaxed);
+    }
+
+    void run() {
+        std::vector<event_loop> loops(thread_count_);
+        for (auto& loop : loops) {
+            loop.epoll_fd = ::epoll_create1(0);
+            watch_listen_(loop, true);
+
+            epoll_event stop_event = {};
+            stop_event.events      = EPOLLIN;
+            stop_event.data.fd     = stop_fd_;
+            ::epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, stop_fd_, &stop_event);
+        }
+
+        {
+            std::vector<std::jthread> workers;
+            for (size_t i = 1; i < loops.size(); i++) {
+                workers.emplace_back([this, &loop = loops[i]] { run_loop_(loop); });
+            }
+            run_loop_(loops[0]);
+        }
+
+        for (auto& loop : loops) {
+            for (auto& [fd, conn] : loop.connections) {
+                ::close(fd);
+            }
+            ::close(loop.epoll_fd);
+        }
+    }
+};
+
+#endif  // GUAP_ALGO_TABLE_SERVER_H
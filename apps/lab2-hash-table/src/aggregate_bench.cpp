@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench_io.h"
+#include "hash_aggregator.h"
+#include "hash_table.h"
+#include "key_workload.h"
+#include "work_stealing_pool.h"
+
+using record = std::pair<packed_key, std::int64_t>;
+
+struct bench_config {
+    size_t records     = 10'000'000;
+    size_t keys        = 100'000;
+    double zipf_s      = 1.2;
+    size_t threads     = std::thread::hardware_concurrency();
+    std::uint64_t seed = 42;
+    std::string output = "aggregate_bench.json";
+};
+
+struct bench_result {
+    std::string distribution;
+    std::string engine;
+    std::string reducer;
+    size_t threads    = 0;
+    size_t partitions = 0;
+    size_t groups     = 0;
+    double seconds    = 0;
+    double mrecords   = 0;
+    bool matches      = true;
+};
+
+bool parse_args(int argc, char** argv, bench_config& config) {
+    auto parsed = parse_options(argc, argv, [&](std::string_view name, std::string_view value) {
+        if (name == "--records") {
+            return parse_value(value, config.records);
+        } else if (name == "--keys") {
+            return parse_value(value, config.keys);
+        } else if (name == "--zipf-s") {
+            return parse_value(value, config.zipf_s);
+        } else if (name == "--threads") {
+            return parse_value(value, config.threads);
+        } else if (name == "--seed") {
+            return parse_value(value, config.seed);
+        } else if (name == "--out") {
+            config.output = value;
+            return true;
+        }
+        return false;
+    });
+    return parsed && config.keys > 0 && config.records > 0;
+}
+
+std::vector<record> make_records(const bench_config& config, key_distribution distribution) {
+    std::mt19937_64 rng(config.seed);
+    key_source keys(distinct_random_keys(config.keys, rng), distribution, config.zipf_s);
+
+    std::vector<record> records(config.records);
+    for (auto& [key, value] : records) {
+        key   = keys(rng);
+        value = static_cast<std::int64_t>(rng() % 1000);
+    }
+    return records;
+}
+
+template <typename F>
+double measure_seconds(F&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+template <typename Reducer>
+bench_result run_aggregator(
+    const std::vector<record>& records,
+    const hash_table<std::int64_t>& expected,
+    size_t threads,
+    Reducer reducer
+) {
+    auto pool = threads > 1 ? std::make_unique<work_stealing_pool>(threads) : nullptr;
+    auto partitions =
+        hash_aggregator<std::int64_t, Reducer>::partitions_for(expected.size(), threads);
+    hash_aggregator<std::int64_t, Reducer> aggregator(partitions, pool.get(), reducer);
+
+    bench_result result;
+    result.engine     = "partitioned";
+    result.threads    = threads;
+    result.partitions = aggregator.partition_count();
+    result.seconds    = measure_seconds([&] { aggregator.add(records); });
+    result.groups     = aggregator.size();
+    result.mrecords   = result.seconds > 0 ? records.size() / result.seconds / 1e6 : 0;
+
+    if constexpr (std::same_as<Reducer, sum_reducer<std::int64_t>>) {
+        result.matches = result.groups == expected.size();
+        aggregator.for_each([&](packed_key key, std::int64_t sum) {
+            const auto* value  = expected.find(key);
+            result.matches    &= value != nullptr && *value == sum;
+        });
+    }
+    return result;
+}
+
+bool write_json(const bench_config& config, const std::vector<bench_result>& results) {
+    auto header = std::format(
+        "{{\"records\": {}, \"keys\": {}, \"zipf_s\": {}, \"threads\": {}, \"seed\": {}}}",
+        config.records,
+        config.keys,
+        config.zipf_s,
+        config.threads,
+        config.seed
+    );
+
+    return write_json(config.output, header, results, [](const bench_result& r) {
+        return std::format(
+            "{{\"distribution\": \"{}\", \"engine\": \"{}\", \"reducer\": \"{}\", "
+            "\"threads\": {}, \"partitions\": {}, \"groups\": {}, \"seconds\": {}, "
+            "\"mrecords_per_sec\": {}, \"matches\": {}}}",
+            r.distribution,
+            r.engine,
+            r.reducer,
+            r.threads,
+            r.partitions,
+            r.groups,
+            r.seconds,
+            r.mrecords,
+            r.matches
+        );
+    });
+}
+
+int main(int argc, char** argv) {
+    bench_config config;
+    if (!parse_args(argc, argv, config)) {
+        std::println(
+            "Использование: {} [--records N] [--keys N] [--zipf-s S] [--threads N] [--seed N] "
+            "[--out file.json]",
+            argv[0]
+        );
+        return 1;
+    }
+    config.threads = std::max<size_t>(config.threads, 1);
+
+    std::println(
+        "{:>8} {:>12} {:>8} {:>8} {:>10} {:>8} {:>10} {:>10} {:>6}",
+        "dist",
+        "engine",
+        "reducer",
+        "threads",
+        "partitions",
+        "groups",
+        "seconds",
+        "Mrec/s",
+        "ok"
+    );
+
+    std::vector<bench_result> results;
+    auto report = [&results](bench_result r, std::string_view distribution, std::string_view name) {
+        r.distribution = distribution;
+        r.reducer      = name;
+        std::println(
+            "{:>8} {:>12} {:>8} {:>8} {:>10} {:>8} {:>10.3f} {:>10.1f} {:>6}",
+            r.distribution,
+            r.engine,
+            r.reducer,
+            r.threads,
+            r.partitions,
+            r.groups,
+            r.seconds,
+            r.mrecords,
+            r.matches ? "да" : "нет"
+        );
+        results.push_back(std::move(r));
+    };
+
+    for (auto distribution : {key_distribution::uniform, key_distribution::zipf}) {
+        auto name    = distribution == key_distribution::zipf ? "zipf" : "uniform";
+        auto records = make_records(config, distribution);
+
+        auto expected = std::make_unique<hash_table<std::int64_t>>();
+        bench_result baseline;
+        baseline.engine  = "operator[]";
+        baseline.threads = 1;
+        baseline.seconds = measure_seconds([&] {
+            for (const auto& [key, value] : records) {
+                (*expected)[key] += value;
+            }
+        });
+        baseline.groups   = expected->size();
+        baseline.mrecords = baseline.seconds > 0 ? records.size() / baseline.seconds / 1e6 : 0;
+        report(baseline, name, "sum");
+
+        auto run = [&](auto reducer, size_t threads, std::string_view label) {
+            report(run_aggregator(records, *expected, threads, reducer), name, label);
+        };
+        run(sum_reducer<std::int64_t>{}, 1, "sum");
+        if (config.threads > 1) {
+            run(sum_reducer<std::int64_t>{}, config.threads, "sum");
+        }
+        run(count_reducer{}, config.threads, "count");
+        run(min_reducer<std::int64_t>{}, config.threads, "min");
+        run(max_reducer<std::int64_t>{}, config.threads, "max");
+    }
+
+    if (!write_json(config, results)) {
+        return 1;
+    }
+    std::println("Результаты сохранены в {}", config.output);
+    return 0;
+}
@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_io.h"
+#include "hash_table.h"
+#include "key_workload.h"
+
+struct bench_config {
+    size_t ops                     = 1'000'000;
+    unsigned find_share            = 90;
+    unsigned insert_share          = 5;
+    unsigned remove_share          = 5;
+    std::vector<double> fills      = {0.5, 1, 2, 4, 8};
+    key_distribution distribution  = key_distribution::uniform;
+    double zipf_s                  = 0.99;
+    bool sequential                = false;
+    bool ordered_chains            = false;
+    double filter_fpr              = 0;
+    std::uint64_t seed             = 42;
+    std::string output             = "hash_table_bench.json";
+};
+
+struct bench_result {
+    double fill          = 0;
+    size_t items         = 0;
+    size_t ops           = 0;
+    double seconds       = 0;
+    double ops_per_sec   = 0;
+    std::uint64_t p50    = 0;
+    std::uint64_t p99    = 0;
+    std::uint64_t p999   = 0;
+    double hit_rate      = 0;
+    size_t memory_bytes  = 0;
+    double avg_chain     = 0;
+    size_t max_chain     = 0;
+    size_t filter_bytes  = 0;
+    double filter_fpr    = 0;
+};
+
+bool parse_args(int argc, char** argv, bench_config& config) {
+    auto parsed = parse_options(argc, argv, [&](std::string_view name, std::string_view value) {
+        if (name == "--ops") {
+            return parse_value(value, config.ops);
+        } else if (name == "--mix") {
+            std::vector<unsigned> shares;
+            if (!parse_list(value, shares, 3)) {
+                return false;
+            }
+            config.find_share   = shares[0];
+            config.insert_share = shares[1];
+            config.remove_share = shares[2];
+        } else if (name == "--fill") {
+            return parse_list(value, config.fills);
+        } else if (name == "--dist") {
+            if (value != "uniform" && value != "zipf") {
+                return false;
+            }
+            config.distribution =
+                value == "zipf" ? key_distribution::zipf : key_distribution::uniform;
+        } else if (name == "--zipf-s") {
+            return parse_value(value, config.zipf_s);
+        } else if (name == "--keys") {
+            if (value != "random" && value != "sequential") {
+                return false;
+            }
+            config.sequential = value == "sequential";
+        } else if (name == "--chains") {
+            if (value != "insertion" && value != "ordered") {
+                return false;
+            }
+            config.ordered_chains = value == "ordered";
+        } else if (name == "--filter") {
+            return parse_value(value, config.filter_fpr);
+        } else if (name == "--seed") {
+            return parse_value(value, config.seed);
+        } else if (name == "--out") {
+            config.output = value;
+        } else {
+            return false;
+        }
+        return true;
+    });
+    return parsed && config.find_share + config.insert_share + config.remove_share > 0;
+}
+
+template <typename Table>
+void collect_chains(const Table& table, bench_result& result) {
+    size_t used = 0;
+    for (size_t i = 0; i < Table::bucket_count; i++) {
+        if (auto size = table.bucket(i).size(); size > 0) {
+            used++;
+            result.max_chain = std::max(result.max_chain, size);
+        }
+    }
+    result.avg_chain    = used ? static_cast<double>(table.size()) / used : 0;
+    result.memory_bytes = sizeof(Table) + table.size() * sizeof(typename Table::item);
+}
+
+bench_result run_fill(const bench_config& config, double fill) {
+    using table_type = hash_table<int>;
+
+    std::mt19937_64 rng(config.seed);
+
+    auto target   = static_cast<size_t>(fill * table_type::bucket_count);
+    auto universe = config.sequential ? sequential_keys(2 * target)
+                                      : distinct_random_keys(2 * target, rng);
+    std::ranges::shuffle(universe, rng);
+
+    auto table = std::make_unique<table_type>();
+    table->set_ordered_chains(config.ordered_chains);
+    if (config.filter_fpr > 0) {
+        table->enable_filter({std::max<size_t>(target, 1), config.filter_fpr});
+    }
+    for (size_t i = 0; i < universe.size() / 2; i++) {
+        table->insert(universe[i], static_cast<int>(i));
+    }
+
+    key_source keys(universe, config.distribution, config.zipf_s);
+    auto total_share = config.find_share + config.insert_share + config.remove_share;
+
+    std::vector<std::uint32_t> latencies(config.ops);
+    size_t finds = 0;
+    size_t hits  = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < config.ops; i++) {
+        auto key  = keys(rng);
+        auto roll = static_cast<unsigned>(rng() % total_share);
+
+        auto op_start = std::chrono::steady_clock::now();
+        if (roll < config.find_share) {
+            finds++;
+            hits += table->contains(key);
+        } else if (roll < config.find_share + config.insert_share) {
+            table->insert(key, static_cast<int>(i));
+        } else {
+            table->remove(key);
+        }
+        auto op_stop = std::chrono::steady_clock::now();
+
+        latencies[i] = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(op_stop - op_start).count()
+        );
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    bench_result result;
+    result.fill        = fill;
+    result.items       = table->size();
+    result.ops         = config.ops;
+    result.seconds     = std::chrono::duration<double>(stop - start).count();
+    result.ops_per_sec = result.seconds > 0 ? config.ops / result.seconds : 0;
+    result.hit_rate    = finds ? static_cast<double>(hits) / finds : 0;
+
+    std::ranges::sort(latencies);
+    auto percentile = [&latencies](double p) -> std::uint64_t {
+        if (latencies.empty()) {
+            return 0;
+        }
+        return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+    result.p50  = percentile(0.5);
+    result.p99  = percentile(0.99);
+    result.p999 = percentile(0.999);
+
+    collect_chains(*table, result);
+
+    auto filter          = table->stats().filter;
+    result.filter_bytes  = filter.memory_bytes;
+    result.filter_fpr    = filter.expected_fpr;
+    result.memory_bytes += filter.memory_bytes;
+    return result;
+}
+
+bool write_json(const bench_config& config, const std::vector<bench_result>& results) {
+    auto header = std::format(
+        "{{\"ops\": {}, \"mix\": [{}, {}, {}], \"distribution\": \"{}\", \"zipf_s\": {}, "
+        "\"keys\": \"{}\", \"chains\": \"{}\", \"filter_fpr\": {}, \"seed\": {}}}",
+        config.ops,
+        config.find_share,
+        config.insert_share,
+        config.remove_share,
+        config.distribution == key_distribution::zipf ? "zipf" : "uniform",
+        config.zipf_s,
+        config.sequential ? "sequential" : "random",
+        config.ordered_chains ? "ordered" : "insertion",
+        config.filter_fpr,
+        config.seed
+    );
+
+    return write_json(config.output, header, results, [](const bench_result& r) {
+        return std::format(
+            "{{\"fill\": {}, \"items\": {}, \"ops\": {}, \"seconds\": {}, "
+            "\"ops_per_sec\": {}, \"p50_ns\": {}, \"p99_ns\": {}, \"p999_ns\": {}, "
+            "\"hit_rate\": {}, \"memory_bytes\": {}, \"avg_chain\": {}, \"max_chain\": {}, "
+            "\"filter_bytes\": {}, \"filter_expected_fpr\": {}}}",
+            r.fill,
+            r.items,
+            r.ops,
+            r.seconds,
+            r.ops_per_sec,
+            r.p50,
+            r.p99,
+            r.p999,
+            r.hit_rate,
+            r.memory_bytes,
+            r.avg_chain,
+            r.max_chain,
+            r.filter_bytes,
+            r.filter_fpr
+        );
+    });
+}
+
+int main(int argc, char** argv) {
+    bench_config config;
+    if (!parse_args(argc, argv, config)) {
+        std::println(
+            "Использование: {} [--ops N] [--mix find,insert,remove] [--fill 0.5,1,2] "
+            "[--dist uniform|zipf] [--zipf-s S] [--keys random|sequential] "
+            "[--chains insertion|ordered] [--filter FPR] [--seed N] [--out file.json]",
+            argv[0]
+        );
+        return 1;
+    }
+
+    std::println(
+        "{:>6} {:>8} {:>12} {:>8} {:>8} {:>8} {:>10} {:>10} {:>6}",
+        "fill",
+        "items",
+        "ops/sec",
+        "p50",
+        "p99",
+        "p999",
+        "memory",
+        "avg_chain",
+        "max"
+    );
+
+    std::vector<bench_result> results;
+    for (auto fill : config.fills) {
+        const auto& r = results.emplace_back(run_fill(config, fill));
+        std::println(
+            "{:>6} {:>8} {:>12.0f} {:>8} {:>8} {:>8} {:>10} {:>10.2f} {:>6}",
+            r.fill,
+            r.items,
+            r.ops_per_sec,
+            r.p50,
+            r.p99,
+            r.p999,
+            r.memory_bytes,
+            r.avg_chain,
+            r.max_chain
+        );
+    }
+
+    if (!write_json(config, results)) {
+        return 1;
+    }
+    std::println("Результаты сохранены в {}", config.output);
+    return 0;
+}
@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_io.h"
+#include "cache_table.h"
+#include "hash_table.h"
+#include "key_workload.h"
+
+struct replay_clock final {
+    using duration   = std::chrono::microseconds;
+    using rep        = duration::rep;
+    using period     = duration::period;
+    using time_point = std::chrono::time_point<replay_clock>;
+
+    static constexpr bool is_steady = true;
+
+    static inline time_point current = {};
+
+    static time_point now() {
+        return current;
+    }
+};
+
+using replay_cache =
+    basic_cache_table<packed_key, int, key_hash<packed_key>, std::equal_to<>, replay_clock>;
+
+struct bench_config {
+    size_t requests                = 2'000'000;
+    size_t keys                    = 100'000;
+    double zipf_s                  = 0.9;
+    std::vector<double> capacities = {0.01, 0.05, 0.1, 0.25};
+    size_t scan_every              = 0;
+    size_t scan_length             = 0;
+    size_t ttl                     = 0;
+    std::string trace;
+    std::uint64_t seed = 42;
+    std::string output = "cache_bench.json";
+};
+
+struct bench_result {
+    std::string policy;
+    double capacity           = 0;
+    size_t items              = 0;
+    double seconds            = 0;
+    double ns_per_request     = 0;
+    double hit_ratio          = 0;
+    std::uint64_t evictions   = 0;
+    std::uint64_t expirations = 0;
+    std::uint64_t promotions  = 0;
+};
+
+bool parse_args(int argc, char** argv, bench_config& config) {
+    auto parsed = parse_options(argc, argv, [&](std::string_view name, std::string_view value) {
+        if (name == "--requests") {
+            return parse_value(value, config.requests);
+        } else if (name == "--keys") {
+            return parse_value(value, config.keys);
+        } else if (name == "--zipf-s") {
+            return parse_value(value, config.zipf_s);
+        } else if (name == "--capacity") {
+            return parse_list(value, config.capacities);
+        } else if (name == "--scan") {
+            std::vector<size_t> scan;
+            if (!parse_list(value, scan, 2)) {
+                return false;
+            }
+            config.scan_every  = scan[0];
+            config.scan_length = scan[1];
+        } else if (name == "--ttl") {
+            return parse_value(value, config.ttl);
+        } else if (name == "--trace") {
+            config.trace = value;
+        } else if (name == "--seed") {
+            return parse_value(value, config.seed);
+        } else if (name == "--out") {
+            config.output = value;
+        } else {
+            return false;
+        }
+        return true;
+    });
+    return parsed && config.keys > 0;
+}
+
+std::vector<packed_key> load_trace(const std::string& path) {
+    std::vector<packed_key> trace;
+    std::ifstream file(path);
+    for (std::string line; std::getline(file, line);) {
+        if (auto key = parse_key(std::string_view(line).substr(0, key_size))) {
+            trace.push_back(key.value());
+        }
+    }
+    return trace;
+}
+
+std::vector<packed_key> make_trace(const bench_config& config) {
+    std::mt19937_64 rng(config.seed);
+    auto universe = distinct_random_keys(config.keys, rng);
+    key_source keys(universe, key_distribution::zipf, config.zipf_s);
+
+    std::vector<packed_key> trace;
+    trace.reserve(config.requests);
+
+    size_t scan_cursor = 0;
+    while (trace.size() < config.requests) {
+        if (config.scan_every != 0 && trace.size() % config.scan_every == 0) {
+            for (size_t i = 0; i < config.scan_length && trace.size() < config.requests; i++) {
+                trace.push_back(universe[scan_cursor++ % universe.size()]);
+            }
+        }
+        if (trace.size() < config.requests) {
+            trace.push_back(keys(rng));
+        }
+    }
+    return trace;
+}
+
+size_t count_distinct(const std::vector<packed_key>& trace) {
+    auto seen = std::make_unique<hash_table<bool>>();
+    for (auto key : trace) {
+        (*seen)[key] = true;
+    }
+    return seen->size();
+}
+
+bench_result replay(
+    const bench_config& config,
+    const std::vector<packed_key>& trace,
+    eviction_policy policy,
+    size_t capacity
+) {
+    auto cache =
+        std::make_unique<replay_cache>(cache_config{.max_items = capacity, .policy = policy});
+    auto ttl   = replay_clock::duration(config.ttl);
+
+    replay_clock::current = {};
+    auto start            = std::chrono::steady_clock::now();
+    for (auto key : trace) {
+        replay_clock::current += replay_clock::duration(1);
+        if (cache->find(key) == nullptr) {
+            cache->insert(key, static_cast<int>(key.value), ttl);
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    auto stats = cache->stats();
+
+    bench_result result;
+    result.policy         = policy == eviction_policy::clock ? "clock" : "slru";
+    result.items          = stats.items;
+    result.seconds        = std::chrono::duration<double>(stop - start).count();
+    result.ns_per_request = trace.empty() ? 0 : result.seconds * 1e9 / trace.size();
+    result.hit_ratio      = stats.hit_ratio();
+    result.evictions      = stats.evictions;
+    result.expirations    = stats.expirations;
+    result.promotions     = stats.promotions;
+    return result;
+}
+
+bench_result replay_lru(const std::vector<packed_key>& trace, size_t capacity) {
+    using order_type = std::list<packed_key>;
+
+    order_type order;
+    auto index = std::make_unique<hash_table<order_type::iterator>>();
+
+    size_t hits      = 0;
+    size_t evictions = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto key : trace) {
+        if (auto* it = index->find(key)) {
+            order.splice(order.begin(), order, *it);
+            hits++;
+            continue;
+        }
+        if (index->size() >= capacity) {
+            index->remove(order.back());
+            order.pop_back();
+            evictions++;
+        }
+        order.push_front(key);
+        index->insert(key, order.begin());
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    bench_result result;
+    result.policy         = "lru";
+    result.items          = index->size();
+    result.seconds        = std::chrono::duration<double>(stop - start).count();
+    result.ns_per_request = trace.empty() ? 0 : result.seconds * 1e9 / trace.size();
+    result.hit_ratio      = trace.empty() ? 0 : static_cast<double>(hits) / trace.size();
+    result.evictions      = evictions;
+    return result;
+}
+
+bool write_json(
+    const bench_config& config,
+    size_t distinct,
+    const std::vector<bench_result>& results
+) {
+    auto header = std::format(
+        "{{\"requests\": {}, \"keys\": {}, \"distinct\": {}, \"zipf_s\": {}, "
+        "\"scan_every\": {}, \"scan_length\": {}, \"ttl\": {}, \"trace\": \"{}\", "
+        "\"seed\": {}}}",
+        config.requests,
+        config.keys,
+        distinct,
+        config.zipf_s,
+        config.scan_every,
+        config.scan_length,
+        config.ttl,
+        config.trace,
+        config.seed
+    );
+
+    return write_json(config.output, header, results, [](const bench_result& r) {
+        return std::format(
+            "{{\"policy\": \"{}\", \"capacity\": {}, \"items\": {}, \"seconds\": {}, "
+            "\"ns_per_request\": {}, \"hit_ratio\": {}, \"evictions\": {}, "
+            "\"expirations\": {}, \"promotions\": {}}}",
+            r.policy,
+            r.capacity,
+            r.items,
+            r.seconds,
+            r.ns_per_request,
+            r.hit_ratio,
+            r.evictions,
+            r.expirations,
+            r.promotions
+        );
+    });
+}
+
+int main(int argc, char** argv) {
+    bench_config config;
+    if (!parse_args(argc, argv, config)) {
+        std::println(
+            "Использование: {} [--requests N] [--keys N] [--zipf-s S] [--capacity 0.01,0.1] "
+            "[--scan every,length] [--ttl ticks] [--trace file] [--seed N] [--out file.json]",
+            argv[0]
+        );
+        return 1;
+    }
+
+    auto trace    = config.trace.empty() ? make_trace(config) : load_trace(config.trace);
+    auto distinct = count_distinct(trace);
+    std::println("Трасса: {} запросов, {} различных ключей", trace.size(), distinct);
+    std::println(
+        "{:>9} {:>8} {:>8} {:>10} {:>10} {:>12} {:>12}",
+        "capacity",
+        "policy",
+        "items",
+        "hit ratio",
+        "ns/req",
+        "evictions",
+        "expirations"
+    );
+
+    std::vector<bench_result> results;
+    for (auto share : config.capacities) {
+        auto capacity = std::max<size_t>(static_cast<size_t>(share * distinct), 1);
+
+        std::vector<bench_result> round;
+        round.push_back(replay_lru(trace, capacity));
+        round.push_back(replay(config, trace, eviction_policy::clock, capacity));
+        round.push_back(replay(config, trace, eviction_policy::segmented_lru, capacity));
+
+        for (auto& r : round) {
+            r.capacity = share;
+            std::println(
+                "{:>9} {:>8} {:>8} {:>10.4f} {:>10.1f} {:>12} {:>12}",
+                r.capacity,
+                r.policy,
+                r.items,
+                r.hit_ratio,
+                r.ns_per_request,
+                r.evictions,
+                r.expirations
+            );
+            results.push_back(r);
+        }
+    }
+
+    if (!write_json(config, distinct, results)) {
+        return 1;
+    }
+    std::println("Результаты сохранены в {}", config.output);
+    return 0;
+}
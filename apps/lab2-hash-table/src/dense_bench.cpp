@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_io.h"
+#include "dense_hash_table.h"
+#include "hash_table.h"
+#include "key_workload.h"
+#include "table_dump.h"
+
+struct bench_config {
+    std::vector<size_t> sizes = {15'000, 150'000, 600'000};
+    size_t rounds             = 20;
+    std::uint64_t seed        = 42;
+    std::string output        = "dense_bench.json";
+};
+
+struct bench_result {
+    std::string layout;
+    size_t items           = 0;
+    double iterate_ns      = 0;
+    double dump_ms         = 0;
+    std::uint64_t checksum = 0;
+};
+
+bool parse_args(int argc, char** argv, bench_config& config) {
+    auto parsed = parse_options(argc, argv, [&](std::string_view name, std::string_view value) {
+        if (name == "--sizes") {
+            return parse_list(value, config.sizes);
+        } else if (name == "--rounds") {
+            return parse_value(value, config.rounds);
+        } else if (name == "--seed") {
+            return parse_value(value, config.seed);
+        } else if (name == "--out") {
+            config.output = value;
+            return true;
+        }
+        return false;
+    });
+    return parsed && config.rounds > 0;
+}
+
+std::uint64_t sum_values(const hash_table<int>& table) {
+    std::uint64_t sum = 0;
+    for (size_t i = 0; i < hash_table<int>::bucket_count; i++) {
+        for (const auto& it : table.bucket(i)) {
+            sum += static_cast<std::uint64_t>(it.value) + it.key.value;
+        }
+    }
+    return sum;
+}
+
+std::uint64_t sum_values(const dense_hash_table<int>& table) {
+    std::uint64_t sum = 0;
+    for (const auto& it : table) {
+        sum += static_cast<std::uint64_t>(it.value) + it.key.value;
+    }
+    return sum;
+}
+
+template <typename Table>
+bench_result run_layout(
+    std::string_view layout,
+    const bench_config& config,
+    const std::vector<packed_key>& keys
+) {
+    auto table = std::make_unique<Table>();
+    for (size_t i = 0; i < keys.size(); i++) {
+        table->insert(keys[i], static_cast<int>(i));
+    }
+
+    bench_result result;
+    result.layout = layout;
+    result.items  = table->size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < config.rounds; r++) {
+        result.checksum += sum_values(*table);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    auto elapsed      = std::chrono::duration<double, std::nano>(stop - start).count();
+    result.iterate_ns = elapsed / (config.rounds * std::max<size_t>(table->size(), 1));
+
+    auto path = std::filesystem::temp_directory_path() / std::format("dense_bench_{}.csv", layout);
+    table_dump_engine engine;
+
+    start = std::chrono::steady_clock::now();
+    engine.dump_csv(*table, path);
+    stop = std::chrono::steady_clock::now();
+
+    result.dump_ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    std::filesystem::remove(path);
+    return result;
+}
+
+bool write_json(const bench_config& config, const std::vector<bench_result>& results) {
+    auto header = std::format("{{\"rounds\": {}, \"seed\": {}}}", config.rounds, config.seed);
+
+    return write_json(config.output, header, results, [](const bench_result& r) {
+        return std::format(
+            "{{\"layout\": \"{}\", \"items\": {}, \"iterate_ns_per_item\": {}, "
+            "\"dump_ms\": {}}}",
+            r.layout,
+            r.items,
+            r.iterate_ns,
+            r.dump_ms
+        );
+    });
+}
+
+int main(int argc, char** argv) {
+    bench_config config;
+    if (!parse_args(argc, argv, config)) {
+        std::println(
+            "Использование: {} [--sizes 15000,150000] [--rounds N] [--seed N] [--out file.json]",
+            argv[0]
+        );
+        return 1;
+    }
+
+    std::println(
+        "{:>8} {:>8} {:>14} {:>10} {:>6}",
+        "items",
+        "layout",
+        "iterate, ns",
+        "dump, ms",
+        "ok"
+    );
+
+    std::vector<bench_result> results;
+    for (auto size : config.sizes) {
+        std::mt19937_64 rng(config.seed);
+        auto keys = distinct_random_keys(size, rng);
+
+        auto nodes = run_layout<hash_table<int>>("nodes", config, keys);
+        auto dense = run_layout<dense_hash_table<int>>("dense", config, keys);
+        for (const auto& r : {nodes, dense}) {
+            std::println(
+                "{:>8} {:>8} {:>14.2f} {:>10.2f} {:>6}",
+                r.items,
+                r.layout,
+                r.iterate_ns,
+                r.dump_ms,
+                r.checksum == nodes.checksum ? "да" : "нет"
+            );
+            results.push_back(r);
+        }
+    }
+
+    if (!write_json(config, results)) {
+        return 1;
+    }
+    std::println("Результаты сохранены в {}", config.output);
+    return 0;
+}
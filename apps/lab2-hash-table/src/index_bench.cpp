@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_io.h"
+#include "hash_table.h"
+#include "key_index.h"
+#include "key_workload.h"
+
+struct bench_config {
+    std::vector<size_t> sizes = {1'500, 15'000, 150'000};
+    size_t queries            = 200;
+    std::uint64_t seed        = 42;
+    std::string output        = "index_bench.json";
+};
+
+struct bench_result {
+    std::string query;
+    size_t items       = 0;
+    size_t matches     = 0;
+    double full_us     = 0;
+    double index_us    = 0;
+    size_t index_bytes = 0;
+    bool same          = true;
+};
+
+bool parse_args(int argc, char** argv, bench_config& config) {
+    auto parsed = parse_options(argc, argv, [&](std::string_view name, std::string_view value) {
+        if (name == "--sizes") {
+            return parse_list(value, config.sizes);
+        } else if (name == "--queries") {
+            return parse_value(value, config.queries);
+        } else if (name == "--seed") {
+            return parse_value(value, config.seed);
+        } else if (name == "--out") {
+            config.output = value;
+            return true;
+        }
+        return false;
+    });
+    return parsed && config.queries > 0;
+}
+
+std::vector<key_range> make_queries(std::string_view kind, size_t count, std::mt19937_64& rng) {
+    std::vector<key_range> ranges;
+    ranges.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if (kind == "range") {
+            auto first = random_key(rng);
+            auto width = static_cast<std::uint32_t>(rng() % (packed_key_count / 1000));
+            auto last  = std::min(first.value + width, packed_key_count - 1);
+            ranges.push_back({first, packed_key{last}});
+        } else {
+            auto text = random_key(rng).str();
+            ranges.push_back(prefix_range(std::string_view(text).substr(0, kind.size())).value());
+        }
+    }
+    return ranges;
+}
+
+struct scan_totals final {
+    size_t matches    = 0;
+    std::uint64_t sum = 0;
+
+    bool operator==(const scan_totals&) const = default;
+};
+
+template <typename Table>
+double measure_us(const Table& table, const std::vector<key_range>& queries, scan_totals& totals) {
+    totals = {};
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& range : queries) {
+        table.scan_range(range, [&totals](packed_key key, int value) {
+            totals.matches++;
+            totals.sum += key.value ^ static_cast<std::uint64_t>(value);
+        });
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(stop - start).count() / queries.size();
+}
+
+bool write_json(const bench_config& config, const std::vector<bench_result>& results) {
+    auto header = std::format("{{\"queries\": {}, \"seed\": {}}}", config.queries, config.seed);
+
+    return write_json(config.output, header, results, [](const bench_result& r) {
+        return std::format(
+            "{{\"items\": {}, \"query\": \"{}\", \"matches_per_query\": {}, "
+            "\"full_scan_us\": {}, \"index_us\": {}, \"index_bytes\": {}, \"same\": {}}}",
+            r.items,
+            r.query,
+            r.matches,
+            r.full_us,
+            r.index_us,
+            r.index_bytes,
+            r.same
+        );
+    });
+}
+
+int main(int argc, char** argv) {
+    bench_config config;
+    if (!parse_args(argc, argv, config)) {
+        std::println(
+            "Использование: {} [--sizes 10000,100000] [--queries N] [--seed N] "
+            "[--out file.json]",
+            argv[0]
+        );
+        return 1;
+    }
+
+    std::println(
+        "{:>8} {:>8} {:>10} {:>14} {:>12} {:>10} {:>6}",
+        "items",
+        "query",
+        "matches",
+        "full scan, us",
+        "index, us",
+        "speedup",
+        "ok"
+    );
+
+    std::vector<bench_result> results;
+    for (auto size : config.sizes) {
+        std::mt19937_64 rng(config.seed);
+        auto keys = distinct_random_keys(size, rng);
+
+        auto plain   = std::make_unique<hash_table<int>>();
+        auto indexed = std::make_unique<hash_table<int>>();
+        indexed->enable_index();
+        for (size_t i = 0; i < keys.size(); i++) {
+            plain->insert(keys[i], static_cast<int>(i));
+            indexed->insert(keys[i], static_cast<int>(i));
+        }
+
+        for (std::string_view kind : {"K", "K1", "K12", "K123", "range"}) {
+            auto queries = make_queries(kind, config.queries, rng);
+            if (kind == "K") {
+                queries.resize(std::min<size_t>(queries.size(), 20));
+            }
+
+            bench_result result;
+            scan_totals full;
+            scan_totals index;
+            result.items       = plain->size();
+            result.query       = kind == "range" ? "range" : std::format("{}*", kind.size());
+            result.full_us     = measure_us(*plain, queries, full);
+            result.index_us    = measure_us(*indexed, queries, index);
+            result.matches     = index.matches / queries.size();
+            result.index_bytes = indexed->stats().index_bytes;
+            result.same        = full == index;
+
+            std::println(
+                "{:>8} {:>8} {:>10} {:>14.2f} {:>12.2f} {:>10.1f} {:>6}",
+                result.items,
+                result.query,
+                result.matches,
+                result.full_us,
+                result.index_us,
+                result.index_us > 0 ? result.full_us / result.index_us : 0,
+                result.same ? "да" : "нет"
+            );
+            results.push_back(std::move(result));
+        }
+    }
+
+    if (!write_json(config, results)) {
+        return 1;
+    }
+    std::println("Результаты сохранены в {}", config.output);
+    return 0;
+}
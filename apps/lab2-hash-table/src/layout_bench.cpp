@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_io.h"
+#include "hash_table.h"
+#include "key_workload.h"
+#include "soa_hash_table.h"
+
+template <size_t N>
+struct payload final {
+    std::array<std::uint8_t, N> bytes = {};
+};
+
+struct bench_config {
+    size_t lookups            = 2'000'000;
+    std::vector<double> fills = {1, 4, 16};
+    std::uint64_t seed        = 42;
+    std::string output        = "layout_bench.json";
+};
+
+struct bench_result {
+    std::string layout;
+    size_t value_bytes     = 0;
+    double fill            = 0;
+    size_t items           = 0;
+    double hit_ns          = 0;
+    double miss_ns         = 0;
+    std::uint64_t checksum = 0;
+};
+
+bool parse_args(int argc, char** argv, bench_config& config) {
+    auto parsed = parse_options(argc, argv, [&](std::string_view name, std::string_view value) {
+        if (name == "--lookups") {
+            return parse_value(value, config.lookups);
+        } else if (name == "--fill") {
+            return parse_list(value, config.fills);
+        } else if (name == "--seed") {
+            return parse_value(value, config.seed);
+        } else if (name == "--out") {
+            config.output = value;
+            return true;
+        }
+        return false;
+    });
+    return parsed && config.lookups > 0;
+}
+
+template <typename Table>
+double measure_ns(const Table& table, const std::vector<packed_key>& keys, std::uint64_t& sum) {
+    auto start = std::chrono::steady_clock::now();
+    for (auto key : keys) {
+        if (const auto* value = table.find(key)) {
+            sum += value->bytes[0];
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / keys.size();
+}
+
+template <typename Table, size_t N>
+bench_result run_layout(
+    std::string_view layout,
+    const bench_config& config,
+    double fill,
+    const std::vector<packed_key>& universe
+) {
+    auto items = universe.size() / 2;
+    auto table = std::make_unique<Table>();
+    for (size_t i = 0; i < items; i++) {
+        payload<N> value;
+        value.bytes[0] = static_cast<std::uint8_t>(i);
+        table->insert(universe[i], value);
+    }
+
+    std::mt19937_64 rng(config.seed + 1);
+    std::vector<packed_key> hits(config.lookups);
+    std::vector<packed_key> misses(config.lookups);
+    for (size_t i = 0; i < config.lookups; i++) {
+        hits[i]   = universe[rng() % items];
+        misses[i] = universe[items + rng() % (universe.size() - items)];
+    }
+
+    bench_result result;
+    result.layout      = layout;
+    result.value_bytes = N;
+    result.fill        = fill;
+    result.items       = table->size();
+    result.hit_ns      = measure_ns(*table, hits, result.checksum);
+    result.miss_ns     = measure_ns(*table, misses, result.checksum);
+    return result;
+}
+
+template <size_t N>
+void run_size(const bench_config& config, std::vector<bench_result>& results) {
+    for (auto fill : config.fills) {
+        std::mt19937_64 rng(config.seed);
+
+        auto target   = static_cast<size_t>(fill * hash_table<int>::bucket_count);
+        auto universe = distinct_random_keys(2 * std::max<size_t>(target, 1), rng);
+
+        auto aos = run_layout<hash_table<payload<N>>, N>("nodes", config, fill, universe);
+        auto soa = run_layout<soa_hash_table<payload<N>>, N>("soa", config, fill, universe);
+        for (const auto& r : {aos, soa}) {
+            std::println(
+                "{:>6} {:>6} {:>8} {:>8} {:>10.1f} {:>10.1f}",
+                r.value_bytes,
+                r.fill,
+                r.layout,
+                r.items,
+                r.hit_ns,
+                r.miss_ns
+            );
+            results.push_back(r);
+        }
+    }
+}
+
+bool write_json(const bench_config& config, const std::vector<bench_result>& results) {
+    auto header = std::format("{{\"lookups\": {}, \"seed\": {}}}", config.lookups, config.seed);
+
+    return write_json(config.output, header, results, [](const bench_result& r) {
+        return std::format(
+            "{{\"layout\": \"{}\", \"value_bytes\": {}, \"fill\": {}, \"items\": {}, "
+            "\"hit_ns\": {}, \"miss_ns\": {}}}",
+            r.layout,
+            r.value_bytes,
+            r.fill,
+            r.items,
+            r.hit_ns,
+            r.miss_ns
+        );
+    });
+}
+
+int main(int argc, char** argv) {
+    bench_config config;
+    if (!parse_args(argc, argv, config)) {
+        std::println(
+            "Использование: {} [--lookups N] [--fill 1,4,16] [--seed N] [--out file.json]",
+            argv[0]
+        );
+        return 1;
+    }
+
+    std::println(
+        "{:>6} {:>6} {:>8} {:>8} {:>10} {:>10}",
+        "V",
+        "fill",
+        "layout",
+        "items",
+        "hit, ns",
+        "miss, ns"
+    );
+
+    std::vector<bench_result> results;
+    run_size<4>(config, results);
+    run_size<64>(config, results);
+    run_size<512>(config, results);
+
+    if (!write_json(config, results)) {
+        return 1;
+    }
+    std::println("Результаты сохранены в {}", config.output);
+    return 0;
+}
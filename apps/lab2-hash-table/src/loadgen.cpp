@@ -0,0 +1,385 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "bench_io.h"
+#include "key_workload.h"
+#include "table_protocol.h"
+#include "table_server.h"
+
+struct loadgen_config {
+    socket_endpoint endpoint          = {"/tmp/lab2-hash-table.sock"};
+    std::vector<size_t> connections   = {1, 2, 4, 8};
+    size_t requests                   = 200'000;
+    size_t pipeline                   = 32;
+    size_t keys                       = 100'000;
+    unsigned get_share                = 80;
+    unsigned put_share                = 15;
+    unsigned remove_share             = 5;
+    key_distribution distribution     = key_distribution::uniform;
+    double zipf_s                     = 0.99;
+    std::uint64_t seed                = 42;
+    std::string output                = "hash_table_loadgen.json";
+};
+
+struct loadgen_result {
+    size_t connections   = 0;
+    size_t requests      = 0;
+    double seconds       = 0;
+    double ops_per_sec   = 0;
+    std::uint64_t p50    = 0;
+    std::uint64_t p99    = 0;
+    std::uint64_t p999   = 0;
+    double hit_rate      = 0;
+    size_t errors        = 0;
+};
+
+struct client_stats {
+    std::vector<std::uint32_t> latencies;
+    size_t gets   = 0;
+    size_t hits   = 0;
+    size_t errors = 0;
+    bool failed   = false;
+};
+
+bool parse_args(int argc, char** argv, loadgen_config& config) {
+    auto parsed = parse_options(argc, argv, [&](std::string_view name, std::string_view value) {
+        if (name == "--unix") {
+            config.endpoint.unix_path = value;
+        } else if (name == "--port") {
+            config.endpoint.unix_path.clear();
+            return parse_value(value, config.endpoint.port);
+        } else if (name == "--connections") {
+            return parse_list(value, config.connections);
+        } else if (name == "--requests") {
+            return parse_value(value, config.requests);
+        } else if (name == "--pipeline") {
+            return parse_value(value, config.pipeline) && config.pipeline > 0;
+        } else if (name == "--keys") {
+            return parse_value(value, config.keys) && config.keys > 0;
+        } else if (name == "--mix") {
+            std::vector<unsigned> shares;
+            if (!parse_list(value, shares, 3)) {
+                return false;
+            }
+            config.get_share    = shares[0];
+            config.put_share    = shares[1];
+            config.remove_share = shares[2];
+        } else if (name == "--dist") {
+            if (value != "uniform" && value != "zipf") {
+                return false;
+            }
+            config.distribution =
+                value == "zipf" ? key_distribution::zipf : key_distribution::uniform;
+        } else if (name == "--zipf-s") {
+            return parse_value(value, config.zipf_s);
+        } else if (name == "--seed") {
+            return parse_value(value, config.seed);
+        } else if (name == "--out") {
+            config.output = value;
+        } else {
+            return false;
+        }
+        return true;
+    });
+    return parsed && config.get_share + config.put_share + config.remove_share > 0;
+}
+
+bool send_all(int fd, std::string_view data) {
+    while (!data.empty()) {
+        auto result = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (result <= 0) {
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(result));
+    }
+    return true;
+}
+
+struct line_reader final {
+private:
+    int fd_ = -1;
+    std::string buffer_;
+    size_t consumed_ = 0;
+    std::vector<size_t> ends_;
+
+public:
+    explicit line_reader(int fd)
+        : fd_(fd) {}
+
+    bool read(size_t count, std::vector<std::string_view>& lines) {
+        buffer_.erase(0, consumed_);
+        consumed_ = 0;
+        ends_.clear();
+
+        size_t scanned = 0;
+        while (ends_.size() < count) {
+            if (auto end = buffer_.find('\n', scanned); end != std::string::npos) {
+                ends_.push_back(end);
+                scanned = end + 1;
+                continue;
+            }
+
+            char chunk[64 * 1024];
+            auto result = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (result <= 0) {
+                return false;
+            }
+            buffer_.append(chunk, static_cast<size_t>(result));
+        }
+
+        lines.clear();
+        for (auto end : ends_) {
+            lines.push_back(std::string_view(buffer_).substr(consumed_, end - consumed_));
+            consumed_ = end + 1;
+        }
+        return true;
+    }
+};
+
+void run_client(
+    const loadgen_config& config,
+    const key_source& keys,
+    size_t requests,
+    std::uint64_t seed,
+    client_stats& stats
+) {
+    int fd = config.endpoint.connect();
+    if (fd < 0) {
+        stats.failed = true;
+        return;
+    }
+
+    std::mt19937_64 rng(seed);
+    auto total_share = config.get_share + config.put_share + config.remove_share;
+
+    line_reader reader(fd);
+    std::string request_buffer;
+    std::vector<table_request<int>> batch;
+    std::vector<std::string_view> lines;
+
+    for (size_t sent = 0; sent < requests;) {
+        auto count = std::min(config.pipeline, requests - sent);
+
+        batch.clear();
+        request_buffer.clear();
+        for (size_t i = 0; i < count; i++) {
+            auto roll = static_cast<unsigned>(rng() % total_share);
+
+            table_request<int> request;
+            request.key = keys(rng);
+            if (roll < config.get_share) {
+                request.command = table_command::get;
+            } else if (roll < config.get_share + config.put_share) {
+                request.command = table_command::put;
+                request.value   = static_cast<int>(rng());
+            } else {
+                request.command = table_command::remove;
+            }
+            append_request(request_buffer, request);
+            batch.push_back(request);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (!send_all(fd, request_buffer) || !reader.read(count, lines)) {
+            stats.failed = true;
+            break;
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        stats.latencies.push_back(static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count()
+        ));
+
+        for (size_t i = 0; i < count; i++) {
+            auto response = parse_response<int>(lines[i]);
+            if (response.status == table_status::error) {
+                stats.errors++;
+            } else if (batch[i].command == table_command::get) {
+                stats.gets++;
+                stats.hits += response.status == table_status::found;
+            }
+        }
+
+        sent += count;
+    }
+
+    ::close(fd);
+}
+
+bool preload(const loadgen_config& config, const std::vector<packed_key>& universe) {
+    int fd = config.endpoint.connect();
+    if (fd < 0) {
+        return false;
+    }
+
+    line_reader reader(fd);
+    std::string buffer;
+    std::vector<std::string_view> lines;
+    bool ok = true;
+    for (size_t first = 0; ok && first < universe.size() / 2; first += 1024) {
+        auto count = std::min<size_t>(1024, universe.size() / 2 - first);
+
+        buffer.clear();
+        for (size_t i = 0; i < count; i++) {
+            append_request(buffer, table_request<int>{table_command::put, universe[first + i], 1});
+        }
+        ok = send_all(fd, buffer) && reader.read(count, lines);
+    }
+
+    ::close(fd);
+    return ok;
+}
+
+loadgen_result run_connections(
+    const loadgen_config& config,
+    const key_source& keys,
+    size_t connections
+) {
+    std::vector<client_stats> stats(connections);
+    auto per_client = (config.requests + connections - 1) / connections;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (size_t i = 0; i < connections; i++) {
+            clients.emplace_back([&, i] {
+                run_client(config, keys, per_client, config.seed + i + 1, stats[i]);
+            });
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    loadgen_result result;
+    result.connections = connections;
+    result.seconds     = std::chrono::duration<double>(stop - start).count();
+
+    std::vector<std::uint32_t> latencies;
+    size_t gets = 0;
+    size_t hits = 0;
+    for (const auto& s : stats) {
+        if (s.failed) {
+            result.errors++;
+        }
+        latencies.insert(latencies.end(), s.latencies.begin(), s.latencies.end());
+        gets          += s.gets;
+        hits          += s.hits;
+        result.errors += s.errors;
+    }
+
+    result.requests    = per_client * connections;
+    result.ops_per_sec = result.seconds > 0 ? result.requests / result.seconds : 0;
+    result.hit_rate    = gets ? static_cast<double>(hits) / gets : 0;
+
+    std::ranges::sort(latencies);
+    auto percentile = [&latencies](double p) -> std::uint64_t {
+        if (latencies.empty()) {
+            return 0;
+        }
+        return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+    result.p50  = percentile(0.5);
+    result.p99  = percentile(0.99);
+    result.p999 = percentile(0.999);
+    return result;
+}
+
+bool write_json(const loadgen_config& config, const std::vector<loadgen_result>& results) {
+    auto header = std::format(
+        "{{\"endpoint\": \"{}\", \"requests\": {}, \"pipeline\": {}, \"keys\": {}, "
+        "\"mix\": [{}, {}, {}], \"distribution\": \"{}\", \"zipf_s\": {}, \"seed\": {}}}",
+        config.endpoint.is_unix() ? config.endpoint.unix_path
+                                  : std::format("127.0.0.1:{}", config.endpoint.port),
+        config.requests,
+        config.pipeline,
+        config.keys,
+        config.get_share,
+        config.put_share,
+        config.remove_share,
+        config.distribution == key_distribution::zipf ? "zipf" : "uniform",
+        config.zipf_s,
+        config.seed
+    );
+
+    return write_json(config.output, header, results, [](const loadgen_result& r) {
+        return std::format(
+            "{{\"connections\": {}, \"requests\": {}, \"seconds\": {}, \"ops_per_sec\": {}, "
+            "\"batch_p50_ns\": {}, \"batch_p99_ns\": {}, \"batch_p999_ns\": {}, "
+            "\"hit_rate\": {}, \"errors\": {}}}",
+            r.connections,
+            r.requests,
+            r.seconds,
+            r.ops_per_sec,
+            r.p50,
+            r.p99,
+            r.p999,
+            r.hit_rate,
+            r.errors
+        );
+    });
+}
+
+int main(int argc, char** argv) {
+    loadgen_config config;
+    if (!parse_args(argc, argv, config)) {
+        std::println(
+            "Использование: {} [--unix path | --port N] [--connections 1,2,4] [--requests N] "
+            "[--pipeline N] [--keys N] [--mix get,put,del] [--dist uniform|zipf] [--zipf-s S] "
+            "[--seed N] [--out file.json]",
+            argv[0]
+        );
+        return 1;
+    }
+
+    std::mt19937_64 rng(config.seed);
+    auto universe = distinct_random_keys(config.keys, rng);
+    if (!preload(config, universe)) {
+        std::println("Не удалось подключиться к серверу.");
+        return 1;
+    }
+    key_source keys(universe, config.distribution, config.zipf_s);
+
+    std::println(
+        "{:>6} {:>10} {:>12} {:>10} {:>10} {:>10} {:>8} {:>6}",
+        "conns",
+        "requests",
+        "ops/sec",
+        "p50",
+        "p99",
+        "p999",
+        "hit",
+        "err"
+    );
+
+    std::vector<loadgen_result> results;
+    for (auto connections : config.connections) {
+        connections   = std::max<size_t>(connections, 1);
+        const auto& r = results.emplace_back(run_connections(config, keys, connections));
+        std::println(
+            "{:>6} {:>10} {:>12.0f} {:>10} {:>10} {:>10} {:>8.3f} {:>6}",
+            r.connections,
+            r.requests,
+            r.ops_per_sec,
+            r.p50,
+            r.p99,
+            r.p999,
+            r.hit_rate,
+            r.errors
+        );
+    }
+
+    if (!write_json(config, results)) {
+        return 1;
+    }
+    std::println("Результаты сохранены в {}", config.output);
+    return 0;
+}
@@ -1,5 +1,16 @@
+#include <cstdio>
+#include <string_view>
+
 #include "hash_table_menu.h"
 
-int main() {
-    return hash_table_menu{}.run();
-}
\ No newline at end of file
+int main(int argc, char** argv) {
+    if (argc == 3 && std::string_view(argv[1]) == "--script") {
+        auto input = open_script(argv[2]);
+        if (!input) {
+            std::fputs("Не удалось открыть файл сценария.\n", stdout);
+            return 1;
+        }
+        return hash_table_menu(input, false).run();
+    }
+    return hash_table_menu().run();
+}
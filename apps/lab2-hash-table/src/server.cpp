@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <csignal>
+#include <print>
+#include <string_view>
+#include <thread>
+
+#include "bench_io.h"
+#include "sharded_table.h"
+#include "table_server.h"
+
+struct server_config {
+    socket_endpoint endpoint = {"/tmp/lab2-hash-table.sock"};
+    size_t threads           = std::max(std::thread::hardware_concurrency(), 1u);
+    size_t shards            = 16;
+};
+
+namespace {
+table_server<int>* active_server = nullptr;
+
+void handle_signal(int) {
+    if (active_server) {
+        active_server->stop();
+    }
+}
+}  // namespace
+
+bool parse_args(int argc, char** argv, server_config& config) {
+    return parse_options(argc, argv, [&](std::string_view name, std::string_view value) {
+        if (name == "--unix") {
+            config.endpoint.unix_path = value;
+            return true;
+        } else if (name == "--port") {
+            config.endpoint.unix_path.clear();
+            return parse_value(value, config.endpoint.port) && config.endpoint.port > 0;
+        } else if (name == "--threads") {
+            return parse_value(value, config.threads) && config.threads > 0;
+        } else if (name == "--shards") {
+            return parse_value(value, config.shards) && config.shards > 0;
+        }
+        return false;
+    });
+}
+
+int main(int argc, char** argv) {
+    server_config config;
+    if (!parse_args(argc, argv, config)) {
+        std::println(
+            "Использование: {} [--unix path | --port N] [--threads N] [--shards N]",
+            argv[0]
+        );
+        return 1;
+    }
+
+    sharded_hash_table<int> table(config.shards);
+    table_server<int> server(table, config.endpoint, config.threads);
+    if (!server.open()) {
+        std::println("Не удалось открыть сокет для прослушивания.");
+        return 1;
+    }
+
+    active_server = &server;
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    if (config.endpoint.is_unix()) {
+        std::println("Сервер слушает {}", config.endpoint.unix_path);
+    } else {
+        std::println("Сервер слушает 127.0.0.1:{}", config.endpoint.port);
+    }
+
+    server.run();
+    active_server = nullptr;
+
+    std::println("Обработано запросов: {}, элементов в таблице: {}", server.served(), table.size());
+    return 0;
+}
@@ -0,0 +1,5 @@
+bool run_small_string_checks();
+
+int main() {
+    return run_small_string_checks() ? 0 : 1;
+}
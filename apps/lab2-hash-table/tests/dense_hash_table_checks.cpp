@@ -0,0 +1,21 @@
+#include "dense_hash_table.h"
+#include "packed_key.h"
+
+namespace dense_hash_table_checks {
+
+static_assert([] {
+    dense_hash_table<int> table;
+    table.insert(to_key("A000AA"), 1);
+    table[to_key("K123LM")] = 2;
+    table.insert(to_key("Z999ZZ"), 3);
+    table.remove(to_key("A000AA"));
+    table.insert(to_key("B000AA"), 4);
+    table.remove_ordered(to_key("K123LM"));
+
+    auto entries = table.entries();
+    return !table.contains(to_key("A000AA")) && !table.contains(to_key("K123LM")) &&
+           table.size() == 2 && entries[0].key == to_key("Z999ZZ") &&
+           entries[1].key == to_key("B000AA") && table[to_key("B000AA")] == 4;
+}());
+
+}  // namespace dense_hash_table_checks
@@ -0,0 +1,133 @@
+#include <concepts>
+#include <cstdio>
+#include <print>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "hash_table.h"
+#include "key_hash.h"
+#include "small_string.h"
+
+namespace small_string_checks {
+
+static_assert(std::totally_ordered<small_string>);
+
+static_assert(requires(const small_string& text, const std::string& str) {
+    { text == "abc" } -> std::same_as<bool>;
+    { "abc" == text } -> std::same_as<bool>;
+    { text != "abc" } -> std::same_as<bool>;
+    { text == str } -> std::same_as<bool>;
+    { text == text } -> std::same_as<bool>;
+    { text < "abc" } -> std::same_as<bool>;
+    { text <=> text } -> std::same_as<std::strong_ordering>;
+});
+
+const std::string inline_text(small_string::inline_capacity, 'i');
+const std::string heap_text(small_string::inline_capacity + 1, 'h');
+
+bool expect(bool condition, std::string_view what) {
+    if (!condition) {
+        std::println(stderr, "small_string: {}", what);
+    }
+    return condition;
+}
+
+bool holds(const small_string& text, std::string_view expected) {
+    return text.size() == expected.size() && text.view() == expected &&
+           text.data()[text.size()] == '\0';
+}
+
+bool check_boundary() {
+    bool ok = true;
+    ok &= expect(holds(small_string(), ""), "empty string");
+    ok &= expect(holds(small_string(inline_text), inline_text), "longest inline string");
+    ok &= expect(holds(small_string(heap_text), heap_text), "shortest heap string");
+    return ok;
+}
+
+bool check_copy() {
+    bool ok = true;
+    for (const auto& text : {inline_text, heap_text}) {
+        small_string source(text);
+        small_string copy(source);
+        ok &= expect(holds(copy, text) && holds(source, text), "copy construction");
+        ok &= expect(copy.data() != source.data(), "copy shares storage");
+    }
+
+    small_string target(inline_text);
+    small_string heap_source(heap_text);
+    target = heap_source;
+
+    ok &= expect(holds(target, heap_text), "copy heap over inline");
+
+    small_string inline_source(inline_text);
+    target = inline_source;
+
+    ok &= expect(holds(target, inline_text), "copy inline over heap");
+
+    const auto& self = target;
+    target           = self;
+
+    ok &= expect(holds(target, inline_text), "self assignment");
+    return ok;
+}
+
+bool check_move() {
+    bool ok = true;
+    for (const auto& text : {inline_text, heap_text}) {
+        small_string source(text);
+        small_string moved(std::move(source));
+        ok &= expect(holds(moved, text), "move construction");
+
+        source = small_string(text);
+
+        ok &= expect(holds(source, text), "reuse after move");
+    }
+
+    small_string heap_source(heap_text);
+    auto* storage = heap_source.data();
+    small_string target(inline_text);
+    target = std::move(heap_source);
+
+    ok &= expect(holds(target, heap_text) && target.data() == storage, "move heap over inline");
+    ok &= expect(holds(heap_source, ""), "moved-from heap string is empty");
+
+    small_string inline_source(inline_text);
+    target = std::move(inline_source);
+
+    ok &= expect(holds(target, inline_text), "move inline over heap");
+    return ok;
+}
+
+bool check_hash() {
+    bool ok = true;
+    key_hash<small_string> hash;
+    for (const auto& text : {inline_text, heap_text}) {
+        small_string key(text);
+        auto expected = hash(text);
+
+        small_string copy(key);
+        ok &= expect(hash(copy) == expected, "hash changes after copy");
+
+        small_string moved(std::move(key));
+        ok &= expect(hash(moved) == expected, "hash changes after move");
+
+        basic_hash_table<small_string, int> table;
+        table.insert(std::move(moved), 1);
+        ok &= expect(table.contains(std::string_view(text)), "key lost after move into table");
+        ok &= expect(table.find(small_string(text)) != nullptr, "key lost after copy");
+    }
+    return ok;
+}
+
+}  // namespace small_string_checks
+
+bool run_small_string_checks() {
+    using namespace small_string_checks;
+    bool ok  = check_boundary();
+    ok      &= check_copy();
+    ok      &= check_move();
+    ok      &= check_hash();
+    return ok;
+}
@@ -0,0 +1,16 @@
+#include "packed_key.h"
+#include "soa_hash_table.h"
+
+namespace soa_hash_table_checks {
+
+static_assert([] {
+    soa_hash_table<int> table;
+    table.insert(to_key("A000AA"), 1);
+    table[to_key("K123LM")] = 2;
+    table.insert(to_key("Z999ZZ"), 3);
+    table.remove(to_key("A000AA"));
+    return !table.contains(to_key("A000AA")) && table[to_key("K123LM")] == 2 &&
+           table[to_key("Z999ZZ")] == 3 && table.size() == 2;
+}());
+
+}  // namespace soa_hash_table_checks
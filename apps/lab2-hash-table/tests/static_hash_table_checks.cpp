@@ -0,0 +1,27 @@
+#include "hash_table.h"
+#include "packed_key.h"
+#include "static_hash_table.h"
+
+namespace static_hash_table_checks {
+
+inline constexpr auto sample = make_static_hash_table<int>({
+    {to_key("A000AA"), 1},
+    {to_key("B123CD"), 2},
+    {to_key("Z999ZZ"), 3},
+});
+
+static_assert(sample.size() == 3);
+static_assert(sample[to_key("A000AA")] == 1);
+static_assert(sample[to_key("B123CD")] == 2);
+static_assert(sample[to_key("Z999ZZ")] == 3);
+static_assert(!sample.contains(to_key("A000AB")));
+
+static_assert([] {
+    hash_table<int> table;
+    table.insert(to_key("A000AA"), 1);
+    table[to_key("K123LM")] = 2;
+    table.remove(to_key("A000AA"));
+    return !table.contains(to_key("A000AA")) && table[to_key("K123LM")] == 2;
+}());
+
+}  // namespace static_hash_table_checks
@@ -3,25 +3,86 @@
 #ifndef GUAP_ALGO_COMB_SORT_H
 #define GUAP_ALGO_COMB_SORT_H
 
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sorting_network.h"
 
 struct comb_sorter {
     mutable size_t comp_count = 0;
     mutable size_t swap_count = 0;
 
-    template <
-        std::random_access_iterator I,
-        std::sentinel_for<I> S,
-        class Comp = std::ranges::less,
-        class Proj = std::identity>
-        requires std::sortable<I, Comp, Proj>
-    constexpr I operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
-        comp_count = 0;
-        swap_count = 0;
+    size_t network_cutoff = sorting_network_max;
+    bool cache_keys       = false;
 
-        auto n = std::ranges::distance(first, last);
-        if (n < 2) {
-            return last;
+private:
+    template <typename K, typename Comp>
+    static constexpr bool packs_key_ =
+        std::integral<K> && !std::same_as<K, bool> && sizeof(K) <= sizeof(std::uint32_t) &&
+        (std::same_as<Comp, std::ranges::less> || std::same_as<Comp, std::ranges::greater>);
+
+    template <typename K, typename Comp>
+    static constexpr std::uint64_t pack_key_(K key, size_t index) {
+        using U   = std::make_unsigned_t<K>;
+        auto bits = static_cast<U>(key);
+        if constexpr (std::signed_integral<K>) {
+            bits ^= static_cast<U>(U{1} << (8 * sizeof(K) - 1));
+        }
+
+        auto order = static_cast<std::uint64_t>(bits);
+        if constexpr (std::same_as<Comp, std::ranges::greater>) {
+            order = ~order & std::numeric_limits<std::uint32_t>::max();
+        }
+        return order << 32 | index;
+    }
+
+    template <typename I>
+    static constexpr size_t permute_(I first, std::vector<size_t>& order) {
+        using D = std::iter_difference_t<I>;
+
+        size_t moves = 0;
+        for (size_t i = 0; i < order.size(); i++) {
+            if (order[i] == i) {
+                continue;
+            }
+
+            auto value = std::ranges::iter_move(first + static_cast<D>(i));
+            auto j     = i;
+            while (order[j] != i) {
+                auto k = order[j];
+                *(first + static_cast<D>(j)) = std::ranges::iter_move(first + static_cast<D>(k));
+                order[j] = j;
+                j        = k;
+                moves++;
+            }
+            *(first + static_cast<D>(j)) = std::move(value);
+            order[j] = j;
+            moves++;
+        }
+        return moves;
+    }
+
+    template <typename I, typename Comp, typename Proj>
+    constexpr void sort_(I first, std::iter_difference_t<I> n, Comp& comp, Proj& proj) const {
+        if constexpr (network_sortable<I>) {
+            if (static_cast<size_t>(n) <= std::min(network_cutoff, sorting_network_max)) {
+                comp_count += sorting_network_sizes[n];
+                swap_count += sort_network(
+                    first,
+                    static_cast<size_t>(n),
+                    [&comp, &proj](const auto& lhs, const auto& rhs) {
+                        return std::invoke(comp, std::invoke(proj, lhs), std::invoke(proj, rhs));
+                    }
+                );
+                return;
+            }
         }
 
         auto step    = n;
@@ -54,10 +115,103 @@ struct comb_sorter {
                     swap_fn(left, right);
                     swapped = true;
                 }
-                i += step;
+                i++;
             }
         }
+    }
+
+public:
+    template <
+        std::random_access_iterator I,
+        std::sentinel_for<I> S,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::indirect_strict_weak_order<Comp, std::projected<I, Proj>>
+    constexpr std::vector<size_t> argsort(I first, S last, Comp comp = {}, Proj proj = {}) const {
+        using key_type = std::remove_cvref_t<std::indirect_result_t<Proj&, I>>;
+
+        auto n = static_cast<size_t>(std::ranges::distance(first, last));
+        std::vector<size_t> order(n);
+
+        comp_count = 0;
+        swap_count = 0;
+
+        if constexpr (packs_key_<key_type, Comp>) {
+            if (n <= std::numeric_limits<std::uint32_t>::max()) {
+                std::vector<std::uint64_t> keys(n);
+                auto it = first;
+                for (size_t i = 0; i < n; i++, ++it) {
+                    keys[i] = pack_key_<key_type, Comp>(std::invoke(proj, *it), i);
+                }
+
+                auto less     = std::ranges::less{};
+                auto identity = std::identity{};
+                sort_(keys.begin(), static_cast<std::ptrdiff_t>(n), less, identity);
+                for (size_t i = 0; i < n; i++) {
+                    order[i] = static_cast<size_t>(static_cast<std::uint32_t>(keys[i]));
+                }
+
+                return order;
+            }
+        }
+
+        std::vector<std::pair<key_type, size_t>> keys;
+        keys.reserve(n);
+        auto it = first;
+        for (size_t i = 0; i < n; i++, ++it) {
+            keys.emplace_back(std::invoke(proj, *it), i);
+        }
+
+        auto stable_comp = [&comp](const auto& lhs, const auto& rhs) {
+            if (std::invoke(comp, lhs.first, rhs.first)) {
+                return true;
+            }
+            return !std::invoke(comp, rhs.first, lhs.first) && lhs.second < rhs.second;
+        };
+        auto identity = std::identity{};
+        sort_(keys.begin(), static_cast<std::ptrdiff_t>(n), stable_comp, identity);
+        for (size_t i = 0; i < n; i++) {
+            order[i] = keys[i].second;
+        }
+
+        return order;
+    }
+
+    template <
+        std::ranges::random_access_range R,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::indirect_strict_weak_order<
+            Comp,
+            std::projected<std::ranges::iterator_t<R>, Proj>>
+    constexpr std::vector<size_t> argsort(R&& r, Comp comp = {}, Proj proj = {}) const {
+        return argsort(
+            std::ranges::begin(r), std::ranges::end(r), std::move(comp), std::move(proj)
+        );
+    }
+
+    template <
+        std::random_access_iterator I,
+        std::sentinel_for<I> S,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::sortable<I, Comp, Proj>
+    constexpr I operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+        comp_count = 0;
+        swap_count = 0;
+
+        auto n = std::ranges::distance(first, last);
+        if (n < 2) {
+            return last;
+        }
+
+        if (cache_keys) {
+            auto order  = argsort(first, last, comp, proj);
+            swap_count += permute_(first, order);
+            return last;
+        }
 
+        sort_(first, n, comp, proj);
         return last;
     }
 
@@ -4,17 +4,19 @@
 #define GUAP_ALGO_COMB_SORT_MENU_H
 
 #include <algorithm>
+#include <cstdio>
 #include <functional>
-#include <iostream>
 #include <map>
 #include <optional>
-#include <print>
 #include <string>
 #include <vector>
 
 #include "comb_sort.h"
+#include "console.h"
+#include "top_k.h"
 
 struct comb_sort_menu {
+    console io_;
     std::vector<int> seq_;
     bool is_running_ = true;
 
@@ -28,37 +30,32 @@ struct comb_sort_menu {
         {"a", "Добавить элемент", [this] { add_element_(); }},
         {"d", "Удалить элемент", [this] { remove_element_(); }},
         {"k", "Найти k-ое по порядку число", [this] { find_k_element_(); }},
+        {"t", "Вывести k наименьших элементов", [this] { print_top_k_(); }},
         {"p", "Вывести все элементы", [this] { print_seq_(); }},
         {"s", "Вывести отсортированные элементы", [this] { print_sort_seq_(); }},
         {"q", "Выход", [this] { is_running_ = false; }},
         {"h", "Показать меню", [this] { print_menu_(); }},
     };
 
+    explicit comb_sort_menu(std::FILE* input = stdin, bool interactive = true)
+        : io_(input, interactive) {}
+
     void print_menu_() {
-        for (const auto& action : actions_) {
-            std::println("{}. {}", action.key, action.help);
+        if (!io_.is_interactive()) {
+            return;
         }
-        std::println();
-    }
 
-    template <typename T>
-    std::optional<T> strict_scan() {
-        T value;
-        std::cin >> value;
-        if (std::cin.fail()) {
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Ошибка ввода.\n";
-            return {};
-        }
-        return {value};
+        for (const auto& action : actions_) {
+            io_.out.println("{}. {}", action.key, action.help);
+        }
+        io_.out.println();
     }
 
     std::string request_choice_() {
         std::optional<std::string> choice;
         while (!choice.has_value()) {
-            std::print(": ");
-            choice = strict_scan<std::string>();
+            io_.prompt(": ");
+            choice = io_.scan<std::string>();
             if (!choice.has_value()) {
                 print_menu_();
             }
@@ -67,9 +64,9 @@ struct comb_sort_menu {
     }
 
     void add_element_() {
-        std::println("Введите значение (целое число)");
-        std::print("> ");
-        std::optional<int> number = strict_scan<int>();
+        io_.prompt("Введите значение (целое число)\n");
+        io_.prompt("> ");
+        std::optional<int> number = io_.scan<int>();
         if (!number.has_value()) {
             return;
         }
@@ -78,18 +75,18 @@ struct comb_sort_menu {
 
     void remove_element_() {
         if (seq_.empty()) {
-            std::println("Нет элементов.");
+            io_.out.println("Нет элементов.");
             return;
         }
 
-        std::println("Введите индекс элемента для удаления");
-        std::print("> ");
-        std::optional<size_t> index = strict_scan<size_t>();
+        io_.prompt("Введите индекс элемента для удаления\n");
+        io_.prompt("> ");
+        std::optional<size_t> index = io_.scan<size_t>();
         if (!index.has_value()) {
             return;
         }
         if (index.value() >= seq_.size()) {
-            std::println("Индекс вне диапазона.");
+            io_.out.println("Индекс вне диапазона.");
             return;
         }
         seq_.erase(seq_.begin() + index.value());
@@ -97,47 +94,74 @@ struct comb_sort_menu {
 
     void find_k_element_() {
         if (seq_.empty()) {
-            std::println("Нет элементов.");
+            io_.out.println("Нет элементов.");
             return;
         }
 
-        std::println("Введите индекс k");
-        std::print("> ");
-        std::optional<size_t> k = strict_scan<size_t>();
+        io_.prompt("Введите индекс k\n");
+        io_.prompt("> ");
+        std::optional<size_t> k = io_.scan<size_t>();
         if (!k.has_value()) {
             return;
         }
         if (k.value() >= seq_.size()) {
-            std::println("Индекс вне диапазона.");
+            io_.out.println("Индекс вне диапазона.");
             return;
         }
 
         auto seq_copy = seq_;
-        comb_sorter sorter;
-        sorter(seq_copy);
+        partial_sorter sorter;
+        sorter.select(seq_copy, seq_copy.begin() + k.value());
+
+        io_.out.println("Элемент с индексом {} после сортировки {}", k.value(), seq_copy[k.value()]);
+        io_.out.println();
+        io_.out.println("Статистика сортировки");
+        io_.out.println("Количество сравнений: {}", sorter.comp_count);
+        io_.out.println("Количество перестановок: {}", sorter.swap_count);
+    }
 
-        std::println("Элемент с индексом {} после сортировки {}", k.value(), seq_copy[k.value()]);
-        std::println();
-        std::println("Статистика сортировки");
-        std::println("Количество сравнений: {}", sorter.comp_count);
-        std::println("Количество перестановок: {}", sorter.swap_count);
+    void print_top_k_() {
+        if (seq_.empty()) {
+            io_.out.println("Нет элементов.");
+            return;
+        }
+
+        io_.prompt("Введите количество элементов k\n");
+        io_.prompt("> ");
+        std::optional<size_t> k = io_.scan<size_t>();
+        if (!k.has_value()) {
+            return;
+        }
+
+        auto seq_copy = seq_;
+        auto middle   = seq_copy.begin() + std::min(k.value(), seq_copy.size());
+        partial_sorter sorter;
+        sorter(seq_copy, middle);
+
+        for (auto it = seq_copy.begin(); it != middle; ++it) {
+            io_.out.print("{} ", *it);
+        }
+        io_.out.println();
+        io_.out.println("Статистика сортировки");
+        io_.out.println("Количество сравнений: {}", sorter.comp_count);
+        io_.out.println("Количество перестановок: {}", sorter.swap_count);
     }
 
     void print_seq_() {
         if (seq_.empty()) {
-            std::println("Нет элементов.");
+            io_.out.println("Нет элементов.");
             return;
         }
 
         for (auto v : seq_) {
-            std::print("{} ", v);
+            io_.out.print("{} ", v);
         }
-        std::println();
+        io_.out.println();
     }
 
     void print_sort_seq_() {
         if (seq_.empty()) {
-            std::println("Нет элементов.");
+            io_.out.println("Нет элементов.");
             return;
         }
 
@@ -146,27 +170,30 @@ struct comb_sort_menu {
         sorter(seq_copy);
 
         for (auto v : seq_copy) {
-            std::print("{} ", v);
+            io_.out.print("{} ", v);
         }
-        std::println();
-        std::println("Статистика сортировки");
-        std::println("Количество сравнений: {}", sorter.comp_count);
-        std::println("Количество перестановок: {}", sorter.swap_count);
+        io_.out.println();
+        io_.out.println("Статистика сортировки");
+        io_.out.println("Количество сравнений: {}", sorter.comp_count);
+        io_.out.println("Количество перестановок: {}", sorter.swap_count);
     }
 
     int run() {
         seq_ = {9, 1, 8, 2, 7, 3, 6, 4, 5, 0};
 
-        print_menu_();
-        while (is_running_) {
-            auto choice    = request_choice_();
-            auto action_it = std::ranges::find(actions_, choice, &menu_action::key);
-            if (action_it != actions_.end()) {
-                action_it->func();
-            } else {
-                std::println("Некорректный выбор. Попробуйте снова.");
-                print_menu_();
+        try {
+            print_menu_();
+            while (is_running_) {
+                auto choice    = request_choice_();
+                auto action_it = std::ranges::find(actions_, choice, &menu_action::key);
+                if (action_it != actions_.end()) {
+                    action_it->func();
+                } else {
+                    io_.out.println("Некорректный выбор. Попробуйте снова.");
+                    print_menu_();
+                }
             }
+        } catch (const end_of_input&) {
         }
         return 0;
     }
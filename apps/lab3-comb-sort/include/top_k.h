@@ -0,0 +1,326 @@
+#pragma once
+
+#ifndef GUAP_ALGO_TOP_K_H
+#define GUAP_ALGO_TOP_K_H
+
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+struct partial_sorter {
+    mutable size_t comp_count = 0;
+    mutable size_t swap_count = 0;
+
+    static constexpr size_t insertion_cutoff = 16;
+
+private:
+    template <typename I, typename Comp, typename Proj>
+    struct context final {
+        const partial_sorter& self;
+        Comp& comp;
+        Proj& proj;
+
+        template <typename T0, typename T1>
+        constexpr bool less(T0&& lhs, T1&& rhs) const {
+            ++self.comp_count;
+            return std::invoke(
+                comp,
+                std::invoke(proj, std::forward<T0>(lhs)),
+                std::invoke(proj, std::forward<T1>(rhs))
+            );
+        }
+
+        constexpr void swap(I lhs, I rhs) const {
+            ++self.swap_count;
+            std::ranges::iter_swap(lhs, rhs);
+        }
+    };
+
+    template <typename I, typename Ctx>
+    static constexpr void sift_down_(
+        I first, std::iter_difference_t<I> root, std::iter_difference_t<I> n, const Ctx& ctx
+    ) {
+        while (true) {
+            auto child = 2 * root + 1;
+            if (child >= n) {
+                return;
+            }
+            if (child + 1 < n && ctx.less(first[child], first[child + 1])) {
+                child++;
+            }
+            if (!ctx.less(first[root], first[child])) {
+                return;
+            }
+            ctx.swap(first + root, first + child);
+            root = child;
+        }
+    }
+
+    template <typename I, typename Ctx>
+    static constexpr void heap_select_(I first, I middle, I last, const Ctx& ctx) {
+        auto k = middle - first;
+        for (auto i = k / 2; i-- > 0;) {
+            sift_down_(first, i, k, ctx);
+        }
+        for (auto it = middle; it < last; ++it) {
+            if (ctx.less(*it, *first)) {
+                ctx.swap(it, first);
+                sift_down_(first, 0, k, ctx);
+            }
+        }
+    }
+
+    template <typename I, typename Ctx>
+    static constexpr void sort_heap_(I first, I middle, const Ctx& ctx) {
+        for (auto i = middle - first - 1; i > 0; i--) {
+            ctx.swap(first, first + i);
+            sift_down_(first, 0, i, ctx);
+        }
+    }
+
+    template <typename I, typename Ctx>
+    static constexpr void insertion_sort_(I first, I last, const Ctx& ctx) {
+        for (auto i = first + 1; i < last; ++i) {
+            for (auto j = i; j > first && ctx.less(*j, *(j - 1)); --j) {
+                ctx.swap(j, j - 1);
+            }
+        }
+    }
+
+    template <typename I, typename Ctx>
+    static constexpr I partition_(I first, I last, const Ctx& ctx) {
+        auto mid = first + (last - first) / 2;
+        if (ctx.less(*mid, *first)) {
+            ctx.swap(first, mid);
+        }
+        if (ctx.less(*(last - 1), *mid)) {
+            ctx.swap(mid, last - 1);
+            if (ctx.less(*mid, *first)) {
+                ctx.swap(first, mid);
+            }
+        }
+        ctx.swap(first, mid);
+
+        auto l = first + 1;
+        auto r = last - 1;
+        while (true) {
+            while (l <= r && ctx.less(*l, *first)) {
+                ++l;
+            }
+            while (l <= r && ctx.less(*first, *r)) {
+                --r;
+            }
+            if (l >= r) {
+                break;
+            }
+            ctx.swap(l, r);
+            ++l;
+            --r;
+        }
+
+        mid = l - 1;
+        if (mid != first) {
+            ctx.swap(first, mid);
+        }
+        return mid;
+    }
+
+    template <typename I, typename Ctx>
+    static constexpr void select_(I first, I nth, I last, const Ctx& ctx) {
+        auto depth = 2 * std::bit_width(static_cast<size_t>(last - first));
+        while (static_cast<size_t>(last - first) > insertion_cutoff) {
+            if (depth-- == 0) {
+                heap_select_(first, nth + 1, last, ctx);
+                if (nth != first) {
+                    ctx.swap(first, nth);
+                }
+                return;
+            }
+
+            auto mid = partition_(first, last, ctx);
+            if (mid == nth) {
+                return;
+            }
+            if (nth < mid) {
+                last = mid;
+            } else {
+                first = mid + 1;
+            }
+        }
+        insertion_sort_(first, last, ctx);
+    }
+
+public:
+    template <
+        std::random_access_iterator I,
+        std::sentinel_for<I> S,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::sortable<I, Comp, Proj>
+    constexpr I operator()(I first, I middle, S last, Comp comp = {}, Proj proj = {}) const {
+        comp_count = 0;
+        swap_count = 0;
+
+        auto end = std::ranges::next(first, last);
+        if (middle == first) {
+            return end;
+        }
+
+        context<I, Comp, Proj> ctx{*this, comp, proj};
+        heap_select_(first, middle, end, ctx);
+        sort_heap_(first, middle, ctx);
+        return end;
+    }
+
+    template <
+        std::ranges::random_access_range R,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+    constexpr std::ranges::borrowed_iterator_t<R> operator()(
+        R&& r, std::ranges::iterator_t<R> middle, Comp comp = {}, Proj proj = {}
+    ) const {
+        return (*this)(
+            std::ranges::begin(r), middle, std::ranges::end(r), std::move(comp), std::move(proj)
+        );
+    }
+
+    template <
+        std::random_access_iterator I,
+        std::sentinel_for<I> S,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::sortable<I, Comp, Proj>
+    constexpr I select(I first, I nth, S last, Comp comp = {}, Proj proj = {}) const {
+        comp_count = 0;
+        swap_count = 0;
+
+        auto end = std::ranges::next(first, last);
+        if (nth == end) {
+            return end;
+        }
+
+        context<I, Comp, Proj> ctx{*this, comp, proj};
+        select_(first, nth, end, ctx);
+        return end;
+    }
+
+    template <
+        std::ranges::random_access_range R,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+    constexpr std::ranges::borrowed_iterator_t<R> select(
+        R&& r, std::ranges::iterator_t<R> nth, Comp comp = {}, Proj proj = {}
+    ) const {
+        return select(
+            std::ranges::begin(r), nth, std::ranges::end(r), std::move(comp), std::move(proj)
+        );
+    }
+};
+
+template <typename T, class Comp = std::ranges::less, class Proj = std::identity>
+    requires std::sortable<typename std::vector<T>::iterator, Comp, Proj>
+struct top_k_stream {
+private:
+    size_t k_;
+    Comp comp_;
+    Proj proj_;
+
+    std::vector<T> buffer_;
+    bool has_threshold_ = false;
+
+    size_t seen_       = 0;
+    size_t comp_count_ = 0;
+    size_t swap_count_ = 0;
+
+    void compact_() {
+        partial_sorter sorter;
+        sorter.select(buffer_, buffer_.begin() + (k_ - 1), comp_, proj_);
+        buffer_.erase(buffer_.begin() + k_, buffer_.end());
+        has_threshold_  = true;
+        comp_count_    += sorter.comp_count;
+        swap_count_    += sorter.swap_count;
+    }
+
+public:
+    explicit top_k_stream(size_t k, Comp comp = {}, Proj proj = {})
+        : k_(k)
+        , comp_(std::move(comp))
+        , proj_(std::move(proj)) {
+        buffer_.reserve(2 * k_);
+    }
+
+    template <typename U>
+    void push(U&& value) {
+        seen_++;
+        if (k_ == 0) {
+            return;
+        }
+
+        if (has_threshold_) {
+            comp_count_++;
+            if (!std::invoke(
+                    comp_,
+                    std::invoke(proj_, std::as_const(value)),
+                    std::invoke(proj_, buffer_[k_ - 1])
+                )) {
+                return;
+            }
+        }
+
+        buffer_.push_back(std::forward<U>(value));
+        if (buffer_.size() == 2 * k_) {
+            compact_();
+        }
+    }
+
+    template <std::ranges::input_range R>
+    void push_range(R&& r) {
+        for (auto&& value : r) {
+            push(std::forward<decltype(value)>(value));
+        }
+    }
+
+    std::vector<T> result() {
+        if (buffer_.size() > k_) {
+            compact_();
+        }
+
+        auto values = buffer_;
+        partial_sorter sorter;
+        sorter(values, values.end(), comp_, proj_);
+        comp_count_ += sorter.comp_count;
+        swap_count_ += sorter.swap_count;
+        return values;
+    }
+
+    void clear() {
+        buffer_.clear();
+        has_threshold_ = false;
+        seen_          = 0;
+        comp_count_    = 0;
+        swap_count_    = 0;
+    }
+
+    size_t k() const {
+        return k_;
+    }
+
+    size_t seen() const {
+        return seen_;
+    }
+
+    size_t comp_count() const {
+        return comp_count_;
+    }
+
+    size_t swap_count() const {
+        return swap_count_;
+    }
+};
+
+#endif  // GUAP_ALGO_TOP_K_H
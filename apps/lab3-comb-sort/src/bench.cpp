@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "comb_sort.h"
+
+constexpr size_t block_arrays = 1 << 16;
+
+template <typename F>
+double measure_ms(size_t n, size_t arrays, std::mt19937& rng, F&& sort) {
+    std::vector<int> source(n * block_arrays);
+    std::vector<int> work(source.size());
+    std::ranges::generate(source, rng);
+
+    double total = 0;
+    for (size_t done = 0; done < arrays; done += block_arrays) {
+        auto count = std::min(block_arrays, arrays - done);
+        std::copy_n(source.begin(), n * count, work.begin());
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++) {
+            sort(work.begin() + i * n, work.begin() + (i + 1) * n);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::milli>(stop - start).count();
+
+        for (size_t i = 0; i < count; i++) {
+            if (!std::is_sorted(work.begin() + i * n, work.begin() + (i + 1) * n)) {
+                std::println("ошибка: последовательность не отсортирована");
+                return total;
+            }
+        }
+    }
+    return total;
+}
+
+int main(int argc, char** argv) {
+    size_t arrays = argc > 1 ? std::stoull(argv[1]) : 2'000'000;
+    std::mt19937 rng(42);
+
+    std::println("Сортировка {} массивов каждого размера", arrays);
+    std::println(
+        "{:>6} {:>14} {:>14} {:>14} {:>10}",
+        "n",
+        "comb, ms",
+        "network, ms",
+        "std::sort, ms",
+        "speedup"
+    );
+
+    for (size_t n : {4, 8, 12, 16, 24, 32, 48, 64}) {
+        auto comb = measure_ms(n, arrays, rng, [](auto first, auto last) {
+            comb_sorter sorter;
+            sorter.network_cutoff = 0;
+            sorter(first, last);
+        });
+        auto network = measure_ms(n, arrays, rng, [](auto first, auto last) {
+            comb_sorter{}(first, last);
+        });
+        auto std_sort = measure_ms(n, arrays, rng, [](auto first, auto last) {
+            std::sort(first, last);
+        });
+
+        std::println(
+            "{:>6} {:>14.3f} {:>14.3f} {:>14.3f} {:>10.2f}",
+            n,
+            comb,
+            network,
+            std_sort,
+            network > 0 ? comb / network : 0
+        );
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "comb_sort.h"
+#include "top_k.h"
+
+template <typename F>
+double measure_ms(const std::vector<int>& source, size_t k, F&& select) {
+    auto seq   = source;
+    auto start = std::chrono::steady_clock::now();
+    auto top   = select(seq, k);
+    auto stop  = std::chrono::steady_clock::now();
+
+    auto expected = source;
+    std::ranges::partial_sort(expected, expected.begin() + k);
+    if (!std::ranges::equal(top, std::vector<int>(expected.begin(), expected.begin() + k))) {
+        std::println("ошибка: неверный результат для k = {}", k);
+    }
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::stoull(argv[1]) : 1'000'000;
+    std::mt19937 rng(42);
+
+    std::vector<int> source(n);
+    std::ranges::generate(source, rng);
+
+    std::println("Выбор k наименьших из {} элементов", n);
+    std::println(
+        "{:>8} {:>12} {:>12} {:>12} {:>12} {:>16} {:>10}",
+        "k",
+        "comb, ms",
+        "partial, ms",
+        "stream, ms",
+        "select, ms",
+        "std::partial, ms",
+        "speedup"
+    );
+
+    for (size_t k : {1, 10, 100, 1'000, 10'000, 100'000}) {
+        if (k > n) {
+            break;
+        }
+
+        auto comb = measure_ms(source, k, [](std::vector<int>& seq, size_t k) {
+            comb_sorter{}(seq);
+            return std::vector<int>(seq.begin(), seq.begin() + k);
+        });
+        auto partial = measure_ms(source, k, [](std::vector<int>& seq, size_t k) {
+            partial_sorter{}(seq, seq.begin() + k);
+            return std::vector<int>(seq.begin(), seq.begin() + k);
+        });
+        auto stream = measure_ms(source, k, [](std::vector<int>& seq, size_t k) {
+            top_k_stream<int> top(k);
+            top.push_range(seq);
+            return top.result();
+        });
+        auto select = measure_ms(source, k, [](std::vector<int>& seq, size_t k) {
+            partial_sorter sorter;
+            sorter.select(seq, seq.begin() + (k - 1));
+            std::vector<int> top(seq.begin(), seq.begin() + k);
+            comb_sorter{}(top);
+            return top;
+        });
+        auto std_partial = measure_ms(source, k, [](std::vector<int>& seq, size_t k) {
+            std::ranges::partial_sort(seq, seq.begin() + k);
+            return std::vector<int>(seq.begin(), seq.begin() + k);
+        });
+
+        std::println(
+            "{:>8} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>16.3f} {:>10.1f}",
+            k,
+            comb,
+            partial,
+            stream,
+            select,
+            std_partial,
+            stream > 0 ? comb / stream : 0
+        );
+    }
+
+    std::println();
+    std::println("Потоковый режим: k = 100 из {} сгенерированных значений", 20 * n);
+
+    top_k_stream<std::uint32_t> top(100);
+    std::mt19937 stream_rng(7);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < 20 * n; i++) {
+        top.push(static_cast<std::uint32_t>(stream_rng()));
+    }
+    auto result = top.result();
+    auto stop   = std::chrono::steady_clock::now();
+
+    std::println(
+        "{:.3f} ms, сравнений {}, минимум {}, буфер не более {} элементов",
+        std::chrono::duration<double, std::milli>(stop - start).count(),
+        top.comp_count(),
+        result.front(),
+        2 * top.k()
+    );
+
+    return 0;
+}
@@ -0,0 +1,291 @@
+#pragma once
+
+#ifndef GUAP_ALGO_QUICK_SORT_H
+#define GUAP_ALGO_QUICK_SORT_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+
+#include "sorting_network.h"
+#include "work_stealing_pool.h"
+
+struct quick_sorter {
+    mutable size_t comp_count = 0;
+    mutable size_t swap_count = 0;
+
+    work_stealing_pool* pool = nullptr;
+    size_t insertion_cutoff  = 24;
+    size_t ninther_cutoff    = 128;
+    size_t parallel_cutoff   = 1 << 14;
+
+    static constexpr int block_size = 64;
+
+private:
+    struct counters final {
+        size_t comp = 0;
+        size_t swap = 0;
+    };
+
+    template <typename I, typename Comp, typename Proj>
+    struct context final {
+        Comp& comp;
+        Proj& proj;
+        counters& count;
+
+        template <typename T0, typename T1>
+        bool less(T0&& lhs, T1&& rhs) const {
+            ++count.comp;
+            return std::invoke(
+                comp,
+                std::invoke(proj, std::forward<T0>(lhs)),
+                std::invoke(proj, std::forward<T1>(rhs))
+            );
+        }
+
+        void swap(I lhs, I rhs) const {
+            ++count.swap;
+            std::ranges::iter_swap(lhs, rhs);
+        }
+
+        void network_sort(I first, size_t n) const {
+            count.comp += sorting_network_sizes[n];
+            count.swap += sort_network(first, n, [this](const auto& lhs, const auto& rhs) {
+                return std::invoke(comp, std::invoke(proj, lhs), std::invoke(proj, rhs));
+            });
+        }
+
+        void sort3(I a, I b, I c) const {
+            if (less(*b, *a)) {
+                swap(a, b);
+            }
+            if (less(*c, *b)) {
+                swap(b, c);
+                if (less(*b, *a)) {
+                    swap(a, b);
+                }
+            }
+        }
+    };
+
+    template <typename I, typename Ctx>
+    static void insertion_sort_(I first, I last, const Ctx& ctx) {
+        for (auto i = first + 1; i < last; ++i) {
+            for (auto j = i; j > first && ctx.less(*j, *(j - 1)); --j) {
+                ctx.swap(j, j - 1);
+            }
+        }
+    }
+
+    template <typename I, typename Ctx>
+    static void small_sort_(I first, I last, const Ctx& ctx) {
+        if constexpr (network_sortable<I>) {
+            if (static_cast<size_t>(last - first) <= sorting_network_max) {
+                ctx.network_sort(first, static_cast<size_t>(last - first));
+                return;
+            }
+        }
+        insertion_sort_(first, last, ctx);
+    }
+
+    template <typename I, typename Ctx>
+    static void sift_down_(
+        I first, std::iter_difference_t<I> root, std::iter_difference_t<I> n, const Ctx& ctx
+    ) {
+        while (true) {
+            auto child = 2 * root + 1;
+            if (child >= n) {
+                return;
+            }
+            if (child + 1 < n && ctx.less(first[child], first[child + 1])) {
+                child++;
+            }
+            if (!ctx.less(first[root], first[child])) {
+                return;
+            }
+            ctx.swap(first + root, first + child);
+            root = child;
+        }
+    }
+
+    template <typename I, typename Ctx>
+    static void heap_sort_(I first, I last, const Ctx& ctx) {
+        auto n = last - first;
+        for (auto i = n / 2; i-- > 0;) {
+            sift_down_(first, i, n, ctx);
+        }
+        for (auto i = n - 1; i > 0; i--) {
+            ctx.swap(first, first + i);
+            sift_down_(first, 0, i, ctx);
+        }
+    }
+
+    template <typename I, typename Ctx>
+    void choose_pivot_(I first, I last, const Ctx& ctx) const {
+        auto n   = last - first;
+        auto mid = first + n / 2;
+        if (static_cast<size_t>(n) > ninther_cutoff) {
+            ctx.sort3(first, mid, last - 1);
+            ctx.sort3(first + 1, mid - 1, last - 2);
+            ctx.sort3(first + 2, mid + 1, last - 3);
+            ctx.sort3(mid - 1, mid, mid + 1);
+        } else {
+            ctx.sort3(first, mid, last - 1);
+        }
+        if (mid != first) {
+            ctx.swap(first, mid);
+        }
+    }
+
+    template <typename I, typename Ctx>
+    static I partition_(I first, I last, const Ctx& ctx) {
+        auto l = first + 1;
+        auto r = last - 1;
+
+        unsigned char offsets_l[block_size];
+        unsigned char offsets_r[block_size];
+        int num_l   = 0;
+        int num_r   = 0;
+        int start_l = 0;
+        int start_r = 0;
+
+        while (r - l + 1 > 2 * block_size) {
+            if (num_l == 0) {
+                start_l = 0;
+                for (int i = 0; i < block_size; i++) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i);
+                    num_l           += !ctx.less(l[i], *first);
+                }
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                for (int i = 0; i < block_size; i++) {
+                    offsets_r[num_r] = static_cast<unsigned char>(i);
+                    num_r           += !ctx.less(*first, *(r - i));
+                }
+            }
+
+            auto num = std::min(num_l, num_r);
+            for (int j = 0; j < num; j++) {
+                ctx.swap(l + offsets_l[start_l + j], r - offsets_r[start_r + j]);
+            }
+            num_l   -= num;
+            num_r   -= num;
+            start_l += num;
+            start_r += num;
+
+            if (num_l == 0) {
+                l += block_size;
+            }
+            if (num_r == 0) {
+                r -= block_size;
+            }
+        }
+
+        while (true) {
+            while (l <= r && ctx.less(*l, *first)) {
+                ++l;
+            }
+            while (l <= r && ctx.less(*first, *r)) {
+                --r;
+            }
+            if (l >= r) {
+                break;
+            }
+            ctx.swap(l, r);
+            ++l;
+            --r;
+        }
+
+        auto mid = l - 1;
+        if (mid != first) {
+            ctx.swap(first, mid);
+        }
+        return mid;
+    }
+
+    template <typename I, typename Comp, typename Proj>
+    void sort_(I first, I last, int depth, Comp& comp, Proj& proj, counters& count) const {
+        task_group group;
+        context<I, Comp, Proj> ctx{comp, proj, count};
+
+        while (static_cast<size_t>(last - first) > insertion_cutoff) {
+            if (depth-- == 0) {
+                heap_sort_(first, last, ctx);
+                break;
+            }
+
+            choose_pivot_(first, last, ctx);
+            auto mid = partition_(first, last, ctx);
+
+            if (pool && static_cast<size_t>(mid - first) > parallel_cutoff) {
+                pool->submit(group, [this, first, mid, depth, &comp, &proj] {
+                    counters local;
+                    sort_(first, mid, depth, comp, proj, local);
+                    merge_counters_(local);
+                });
+            } else if (mid - first < last - mid) {
+                sort_(first, mid, depth, comp, proj, count);
+            } else {
+                sort_(mid + 1, last, depth, comp, proj, count);
+                last = mid;
+                continue;
+            }
+            first = mid + 1;
+        }
+
+        if (static_cast<size_t>(last - first) <= insertion_cutoff && last - first > 1) {
+            small_sort_(first, last, ctx);
+        }
+
+        if (pool) {
+            pool->wait(group);
+        }
+    }
+
+    void merge_counters_(const counters& local) const {
+        std::atomic_ref(comp_count).fetch_add(local.comp, std::memory_order_relaxed);
+        std::atomic_ref(swap_count).fetch_add(local.swap, std::memory_order_relaxed);
+    }
+
+public:
+    template <
+        std::random_access_iterator I,
+        std::sentinel_for<I> S,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::sortable<I, Comp, Proj>
+    I operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+        comp_count = 0;
+        swap_count = 0;
+
+        auto end = std::ranges::next(first, last);
+        auto n   = end - first;
+        if (n < 2) {
+            return end;
+        }
+
+        counters local;
+        sort_(first, end, 2 * std::bit_width(static_cast<size_t>(n)), comp, proj, local);
+        merge_counters_(local);
+
+        return end;
+    }
+
+    template <
+        std::ranges::random_access_range R,
+        class Comp = std::ranges::less,
+        class Proj = std::identity>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+    std::ranges::borrowed_iterator_t<R> operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
+        return (*this)(
+            std::ranges::begin(r), std::ranges::end(r), std::move(comp), std::move(proj)
+        );
+    }
+};
+
+#endif  // GUAP_ALGO_QUICK_SORT_H
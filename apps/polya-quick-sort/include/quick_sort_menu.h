@@ -0,0 +1,159 @@
+#pragma once
+
+#ifndef GUAP_ALGO_QUICK_SORT_MENU_H
+#define GUAP_ALGO_QUICK_SORT_MENU_H
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "console.h"
+#include "quick_sort.h"
+#include "work_stealing_pool.h"
+
+struct quick_sort_menu {
+    console io_;
+    std::vector<int> seq_;
+    std::unique_ptr<work_stealing_pool> pool_;
+    bool is_parallel_ = false;
+    bool is_running_  = true;
+
+    struct menu_action {
+        std::string key;
+        std::string help;
+        std::function<void()> func;
+    };
+
+    std::vector<menu_action> actions_ = {
+        {"a", "Добавить элемент", [this] { add_element_(); }},
+        {"d", "Удалить элемент", [this] { remove_element_(); }},
+        {"p", "Вывести все элементы", [this] { print_seq_(); }},
+        {"s", "Вывести отсортированные элементы", [this] { print_sort_seq_(); }},
+        {"m", "Переключить параллельный режим", [this] { toggle_parallel_(); }},
+        {"q", "Выход", [this] { is_running_ = false; }},
+        {"h", "Показать меню", [this] { print_menu_(); }},
+    };
+
+    explicit quick_sort_menu(std::FILE* input = stdin, bool interactive = true)
+        : io_(input, interactive) {}
+
+    void print_menu_() {
+        if (!io_.is_interactive()) {
+            return;
+        }
+
+        for (const auto& action : actions_) {
+            io_.out.println("{}. {}", action.key, action.help);
+        }
+        io_.out.println();
+    }
+
+    std::string request_choice_() {
+        std::optional<std::string> choice;
+        while (!choice.has_value()) {
+            io_.prompt(": ");
+            choice = io_.scan<std::string>();
+            if (!choice.has_value()) {
+                print_menu_();
+            }
+        }
+        return choice.value();
+    }
+
+    void add_element_() {
+        io_.prompt("Введите значение (целое число)\n");
+        io_.prompt("> ");
+        std::optional<int> number = io_.scan<int>();
+        if (!number.has_value()) {
+            return;
+        }
+        seq_.push_back(number.value());
+    }
+
+    void remove_element_() {
+        if (seq_.empty()) {
+            io_.out.println("Нет элементов.");
+            return;
+        }
+
+        io_.prompt("Введите индекс элемента для удаления\n");
+        io_.prompt("> ");
+        std::optional<size_t> index = io_.scan<size_t>();
+        if (!index.has_value()) {
+            return;
+        }
+        if (index.value() >= seq_.size()) {
+            io_.out.println("Индекс вне диапазона.");
+            return;
+        }
+        seq_.erase(seq_.begin() + index.value());
+    }
+
+    void print_seq_() {
+        if (seq_.empty()) {
+            io_.out.println("Нет элементов.");
+            return;
+        }
+
+        for (auto v : seq_) {
+            io_.out.print("{} ", v);
+        }
+        io_.out.println();
+    }
+
+    void toggle_parallel_() {
+        is_parallel_ = !is_parallel_;
+        io_.out.println("Параллельный режим {}", is_parallel_ ? "включён" : "выключен");
+    }
+
+    void print_sort_seq_() {
+        if (seq_.empty()) {
+            io_.out.println("Нет элементов.");
+            return;
+        }
+
+        auto seq_copy = seq_;
+        quick_sorter sorter;
+        if (is_parallel_) {
+            if (!pool_) {
+                pool_ = std::make_unique<work_stealing_pool>();
+            }
+            sorter.pool = pool_.get();
+        }
+        sorter(seq_copy);
+
+        for (auto v : seq_copy) {
+            io_.out.print("{} ", v);
+        }
+        io_.out.println();
+        io_.out.println("Статистика сортировки");
+        io_.out.println("Количество сравнений: {}", sorter.comp_count);
+        io_.out.println("Количество перестановок: {}", sorter.swap_count);
+    }
+
+    int run() {
+        seq_ = {9, 1, 8, 2, 7, 3, 6, 4, 5, 0};
+
+        try {
+            print_menu_();
+            while (is_running_) {
+                auto choice    = request_choice_();
+                auto action_it = std::ranges::find(actions_, choice, &menu_action::key);
+                if (action_it != actions_.end()) {
+                    action_it->func();
+                } else {
+                    io_.out.println("Некорректный выбор. Попробуйте снова.");
+                    print_menu_();
+                }
+            }
+        } catch (const end_of_input&) {
+        }
+        return 0;
+    }
+};
+
+#endif  // GUAP_ALGO_QUICK_SORT_MENU_H
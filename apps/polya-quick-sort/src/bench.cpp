@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "comb_sort.h"
+#include "quick_sort.h"
+#include "work_stealing_pool.h"
+
+struct distribution {
+    std::string name;
+    std::function<std::vector<int>(size_t)> make;
+};
+
+template <typename F>
+double measure_ms(std::vector<int> seq, F&& sort) {
+    auto start = std::chrono::steady_clock::now();
+    sort(seq);
+    auto stop = std::chrono::steady_clock::now();
+
+    if (!std::ranges::is_sorted(seq)) {
+        std::println("ошибка: последовательность не отсортирована");
+    }
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main() {
+    std::mt19937 rng(42);
+    work_stealing_pool pool;
+
+    std::vector<distribution> distributions = {
+        {"random",
+         [&rng](size_t n) {
+             std::vector<int> seq(n);
+             std::ranges::generate(seq, rng);
+             return seq;
+         }},
+        {"sorted",
+         [](size_t n) {
+             std::vector<int> seq(n);
+             std::iota(seq.begin(), seq.end(), 0);
+             return seq;
+         }},
+        {"reversed",
+         [](size_t n) {
+             std::vector<int> seq(n);
+             std::iota(seq.begin(), seq.end(), 0);
+             std::ranges::reverse(seq);
+             return seq;
+         }},
+        {"few_unique",
+         [&rng](size_t n) {
+             std::vector<int> seq(n);
+             std::ranges::generate(seq, [&rng] { return static_cast<int>(rng() % 16); });
+             return seq;
+         }},
+    };
+
+    std::println(
+        "{:>12} {:>10} {:>14} {:>14} {:>14} {:>14}",
+        "distribution",
+        "n",
+        "quick, ms",
+        "quick_par, ms",
+        "comb, ms",
+        "std::sort, ms"
+    );
+
+    for (size_t n : {1'000, 10'000, 100'000, 1'000'000}) {
+        for (const auto& dist : distributions) {
+            auto seq = dist.make(n);
+
+            auto quick = measure_ms(seq, [](auto& s) { quick_sorter{}(s); });
+            auto quick_par = measure_ms(seq, [&pool](auto& s) {
+                quick_sorter sorter;
+                sorter.pool = &pool;
+                sorter(s);
+            });
+            auto comb = measure_ms(seq, [](auto& s) { comb_sorter{}(s); });
+            auto std_sort = measure_ms(seq, [](auto& s) { std::ranges::sort(s); });
+
+            std::println(
+                "{:>12} {:>10} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f}",
+                dist.name,
+                n,
+                quick,
+                quick_par,
+                comb,
+                std_sort
+            );
+        }
+    }
+
+    return 0;
+}
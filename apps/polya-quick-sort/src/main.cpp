@@ -0,0 +1,16 @@
+#include <cstdio>
+#include <string_view>
+
+#include "quick_sort_menu.h"
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::string_view(argv[1]) == "--script") {
+        auto input = open_script(argv[2]);
+        if (!input) {
+            std::fputs("Не удалось открыть файл сценария.\n", stdout);
+            return 1;
+        }
+        return quick_sort_menu(input, false).run();
+    }
+    return quick_sort_menu().run();
+}